@@ -280,6 +280,58 @@ static int open_temp_bookmark(char *buf,
     return fd;
 }
 
+/* ----------------------------------------------------------------------- */
+/* This function checks whether a bookmark is the newest one in a file     */
+/* already, e.g. when playback is stopped again right after resuming.      */
+/* ------------------------------------------------------------------------*/
+static bool is_newest_bookmark(const char* bookmark_file_name,
+                               const char* bookmark)
+{
+    char line[MAX_BOOKMARK_SIZE];
+    bool equal = false;
+    int fd = open(bookmark_file_name, O_RDONLY);
+
+    if (fd >= 0)
+    {
+        equal = read_line(fd, line, sizeof(line)) > 0 && !strcmp(line, bookmark);
+        close(fd);
+    }
+
+    return equal;
+}
+
+/* ----------------------------------------------------------------------- */
+/* This function copies the rest of an open file, up to the first line     */
+/* which isn't a valid bookmark. Lines are written out in blocks.          */
+/* ------------------------------------------------------------------------*/
+static void copy_bookmarks(int dest_fd, int src_fd)
+{
+    char buf[512];
+    size_t used = 0;
+    int len;
+
+    while ((len = read_line(src_fd, global_temp_buffer,
+                            sizeof(global_temp_buffer))) > 0)
+    {
+        if (!parse_bookmark(NULL, 0, global_temp_buffer, NULL, false))
+            break;
+
+        len = strlen(global_temp_buffer);
+        if (used + len + 1 > sizeof(buf))
+        {
+            if (write(dest_fd, buf, used) != (ssize_t)used)
+                return;
+            used = 0;
+        }
+        memcpy(&buf[used], global_temp_buffer, len);
+        used += len;
+        buf[used++] = '\n';
+    }
+
+    if (used > 0)
+        write(dest_fd, buf, used);
+}
+
 /* ----------------------------------------------------------------------- */
 /* This function adds a bookmark to a file.                                */
 /* Returns true on successful bookmark add.                                */
@@ -301,6 +353,10 @@ static bool add_bookmark(const char* bookmark_file_name,
     if (!bookmark)
         return false; /* no bookmark */
 
+    /* don't rewrite the whole file for a bookmark it starts with already */
+    if (is_newest_bookmark(bookmark_file_name, bookmark))
+        return true;
+
     /* Opening up a temp bookmark file */
     temp_bookmark_file = open_temp_bookmark(fnamebuf,
                                             sizeof(fnamebuf),
@@ -332,7 +388,13 @@ static bool add_bookmark(const char* bookmark_file_name,
     /* Reading in the previous bookmarks and writing them to the temp file */
     logf("opening old bookmark %s", bookmark_file_name);
     bookmark_file = open(bookmark_file_name, O_RDONLY);
-    if (bookmark_file >= 0)
+    if (bookmark_file >= 0 && !most_recent)
+    {
+        /* directory bookmarks are neither filtered nor capped */
+        copy_bookmarks(temp_bookmark_file, bookmark_file);
+        close(bookmark_file);
+    }
+    else if (bookmark_file >= 0)
     {
         while (read_line(bookmark_file, global_temp_buffer,
                          sizeof(global_temp_buffer)) > 0)
@@ -86,6 +86,9 @@
 #include "pcmbuf.h"
 #include "buffering.h"
 #include "playback.h"
+#ifdef HAVE_RECORDING
+#include "pcm_record.h"
+#endif
 #if defined(HAVE_SPDIF_OUT) || defined(HAVE_SPDIF_IN)
 #include "spdif.h"
 #endif
@@ -1995,6 +1998,49 @@ static bool dbg_tagcache_info(void)
 }
 #endif
 
+#ifdef HAVE_RECORDING
+static int recording_stats_callback(int btn, struct gui_synclist *lists)
+{
+    (void)lists;
+    struct pcm_rec_stats stats;
+    pcm_rec_get_stats(&stats);
+
+    /* bytes of 16-bit stereo PCM to milliseconds */
+    unsigned long bytes_per_sec = MAX(stats.sample_rate, 1) * 4;
+
+    simplelist_reset_lines();
+    simplelist_addline("PCM: %lu/%lu KB (%lu ms)",
+                       (unsigned long)stats.pcm_buf_used / 1024,
+                       (unsigned long)stats.pcm_buf_size / 1024,
+                       (unsigned long)stats.pcm_buf_used * 1000 / bytes_per_sec);
+    simplelist_addline("PCM peak: %lu KB (%lu ms)",
+                       (unsigned long)stats.pcm_buf_peak / 1024,
+                       (unsigned long)stats.pcm_buf_peak * 1000 / bytes_per_sec);
+    simplelist_addline("PCM overflows: %u", stats.pcm_overflows);
+    simplelist_addline("Enc peak: %lu/%lu KB",
+                       (unsigned long)stats.enc_buf_peak / 1024,
+                       (unsigned long)stats.enc_buf_size / 1024);
+    simplelist_addline("Enc stalls: %u", stats.enc_stalls);
+    simplelist_addline("Enc overflows: %u", stats.enc_overflows);
+    simplelist_addline("Write peak: %ld ms",
+                       stats.write_peak_ticks * 1000 / HZ);
+
+    if (btn == ACTION_NONE)
+        btn = ACTION_REDRAW;
+    return btn;
+}
+
+static bool dbg_recording_stats(void)
+{
+    struct simplelist_info info;
+    simplelist_info_init(&info, "Recording Stats", 0, NULL);
+    info.action_callback = recording_stats_callback;
+    info.scroll_all = true;
+    info.timeout = HZ/2;
+    return simplelist_show_list(&info);
+}
+#endif /* HAVE_RECORDING */
+
 #if defined CPU_COLDFIRE
 static bool dbg_save_roms(void)
 {
@@ -2504,6 +2550,8 @@ static bool dbg_talk(void)
     simplelist_addline(" %d", data.cached_clips);
     simplelist_setline("Cache hits / misses:");
     simplelist_addline("%d / %d", data.cache_hits, data.cache_misses);
+    simplelist_setline("Prefetched clips / used:");
+    simplelist_addline("%d / %d", data.prefetches, data.prefetch_hits);
 
     return simplelist_show_list(&list);
 }
@@ -2819,6 +2867,9 @@ static const struct {
         { "View database info", dbg_tagcache_info },
 #endif
         { "View buffering thread", dbg_buffering_thread },
+#ifdef HAVE_RECORDING
+        { "View recording stats", dbg_recording_stats },
+#endif
 #ifdef PM_DEBUG
         { "pm histogram", peak_meter_histogram},
 #endif /* PM_DEBUG */
@@ -102,6 +102,7 @@ static void mp3_enc_get_caps(const struct encoder_config *cfg,
 static void mp3_enc_default_config(struct encoder_config *cfg)
 {
     cfg->mp3_enc.bitrate = 128; /* default that works for all types */
+    cfg->mp3_enc.speed   = MP3_ENC_SPEED_CFG_DEFAULT;
 } /* mp3_enc_default_config */
 
 static void mp3_enc_convert_config(struct encoder_config *cfg,
@@ -112,12 +113,16 @@ static void mp3_enc_convert_config(struct encoder_config *cfg,
         global_settings.mp3_enc_config.bitrate =
             round_value_to_list32(cfg->mp3_enc.bitrate, mp3_enc_bitr,
                                   MP3_ENC_NUM_BITR, false);
+        global_settings.mp3_enc_config.speed = cfg->mp3_enc.speed;
     }
     else
     {
         if ((unsigned)global_settings.mp3_enc_config.bitrate >= MP3_ENC_NUM_BITR)
             global_settings.mp3_enc_config.bitrate = MP3_ENC_BITRATE_CFG_DEFAULT;
         cfg->mp3_enc.bitrate = mp3_enc_bitr[global_settings.mp3_enc_config.bitrate];
+        if ((unsigned)global_settings.mp3_enc_config.speed >= MP3_ENC_NUM_SPEED)
+            global_settings.mp3_enc_config.speed = MP3_ENC_SPEED_CFG_DEFAULT;
+        cfg->mp3_enc.speed = global_settings.mp3_enc_config.speed;
     }
 } /* mp3_enc_convert_config */
 
@@ -192,13 +197,31 @@ static bool mp3_enc_bitrate(struct menucallback_data *data)
     return res;
 } /* mp3_enc_bitrate */
 
+/* mp3_enc: show the speed preset options */
+static bool mp3_enc_speed(struct menucallback_data *data)
+{
+    struct encoder_config *cfg = data->cfg;
+    static const struct opt_items items[MP3_ENC_NUM_SPEED] =
+    {
+        [MP3_ENC_SPEED_NORMAL]    = { STR(LANG_NORMAL) },
+        [MP3_ENC_SPEED_FAST]      = { STR(LANG_FAST) },
+        [MP3_ENC_SPEED_VERY_FAST] = { STR(LANG_VERY_FAST) },
+    };
+
+    return set_option(str(LANG_SPEED), &cfg->mp3_enc.speed, RB_INT,
+                      items, MP3_ENC_NUM_SPEED, NULL);
+} /* mp3_enc_speed */
+
 /* mp3_enc configuration menu */
 MENUITEM_FUNCTION_W_PARAM(mp3_bitrate, 0, ID2P(LANG_BITRATE),
                    mp3_enc_bitrate, &menu_callback_data,
                    enc_menuitem_callback, Icon_NOICON);
+MENUITEM_FUNCTION_W_PARAM(mp3_speed, 0, ID2P(LANG_SPEED),
+                   mp3_enc_speed, &menu_callback_data,
+                   enc_menuitem_callback, Icon_NOICON);
 MAKE_MENU( mp3_enc_menu, ID2P(LANG_ENCODER_SETTINGS),
            enc_menuitem_enteritem, Icon_NOICON,
-           &mp3_bitrate);
+           &mp3_bitrate, &mp3_speed);
 
 
 /** wav_enc.codec **/
@@ -60,8 +60,32 @@ static struct compare_data
     int sort_dir; /* qsort key for sorting directories */
     int sort_file; /*       ...for sorting files       */
     int(*_compar)(const char*, const char*, size_t);
+    bool use_keys; /* entries are sorted by natsort_by_keys() */
 } cmp_data;
 
+/* Index of the .talk thumbnails of a directory, collected while it is read
+ * so files can be matched with their clips without walking the directory
+ * again. It grows with the number of clips found and is freed once the
+ * loaded files are marked. Open addressing table of name hashes, 0 marks
+ * an empty slot. */
+static struct
+{
+    int handle;    /* 0 until the first .talk file is found */
+    unsigned int mask;
+    unsigned int count;
+    bool building; /* being filled by ft_read_entries() */
+    bool valid;    /* covers the whole directory */
+} thumbs;
+
+/* The directory whose pages are in the tree's cache, either the browser's
+ * or a tempdir given to ft_load() or ft_iter_init() */
+static struct
+{
+    char dir[MAX_PATH];
+    bool browser;     /* filtered by the browser's callback */
+    unsigned int gen; /* counts the pages loaded, see ft_iter_next() */
+} pages;
+
 /* dummmy functions to allow compatibility with strncmp & strncasecmp */
 static int strnatcmp_n(const char *a, const char *b, size_t n)
 {
@@ -82,9 +106,8 @@ int ft_build_playlist(struct tree_context* c, int start_index)
     struct playlist_info *playlist = playlist_get_current();
 
     tree_lock_cache(c);
-    struct entry *entries = tree_get_entries(c);
     bool exceeds_pl = false;
-    if (c->filesindir > playlist->max_playlist_size)
+    if (c->dirlength > playlist->max_playlist_size)
     {
         exceeds_pl = true;
         start_index = 0;
@@ -96,11 +119,11 @@ int ft_build_playlist(struct tree_context* c, int start_index)
     if (res >= 0)
     {
         cpu_boost(true);
-        for(i = 0;i < c->filesindir;i++)
+        for(i = 0;i < c->dirlength;i++)
         {
             int item = i;
             if (exceeds_pl)
-                item = (i + start) % c->filesindir;
+                item = (i + start) % c->dirlength;
 #if 0 /*only needed if displaying progress */
             /* user abort */
             if (action_userabort(TIMEOUT_NOBLOCK))
@@ -108,9 +131,14 @@ int ft_build_playlist(struct tree_context* c, int start_index)
                 break;
             }
 #endif
-            if((entries[item].attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
+            /* loads the pages of a paged directory one after the other */
+            struct entry *entry = tree_get_entry_at(c, item);
+            if (!entry)
+                break;
+
+            if((entry->attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
             {
-                res = playlist_insert_context_add(&pl_context, entries[item].name);
+                res = playlist_insert_context_add(&pl_context, entry->name);
                 if (res < 0)
                     break;
             }
@@ -226,6 +254,156 @@ static void check_file_thumbnails(struct tree_context* c)
     closedir(dir);
 }
 
+static uint32_t thumb_hash(const char *name, size_t len)
+{
+    uint32_t hash = 5381;
+    while (len--)
+        hash = hash * 33 + tolower((unsigned char)*name++);
+    return hash ? hash : 1;
+}
+
+/* prepare an empty index for the directory about to be read */
+static void thumbs_begin(void)
+{
+    thumbs.handle = core_free(thumbs.handle);
+    thumbs.mask = 0;
+    thumbs.count = 0;
+    thumbs.valid = thumbs.building = global_settings.talk_file_clip;
+}
+
+static void thumbs_end(void)
+{
+    thumbs.building = false;
+}
+
+static void thumbs_insert(uint32_t *table, uint32_t hash)
+{
+    unsigned int i = hash & thumbs.mask;
+
+    while (table[i] && table[i] != hash)
+        i = (i + 1) & thumbs.mask;
+    table[i] = hash;
+}
+
+/* double the size of the table, returns false if there is no memory */
+static bool thumbs_grow(void)
+{
+    unsigned int old_size = thumbs.handle > 0 ? thumbs.mask + 1 : 0;
+    unsigned int size = old_size ? old_size * 2 : 16;
+
+    if (size * sizeof(uint32_t) > core_allocatable())
+        return false;
+    int handle = core_alloc(size * sizeof(uint32_t));
+    if (handle <= 0)
+        return false;
+
+    uint32_t *table = core_get_data(handle);
+    memset(table, 0, size * sizeof(uint32_t));
+    thumbs.mask = size - 1;
+
+    if (old_size)
+    {
+        const uint32_t *old_table = core_get_data(thumbs.handle);
+        for (unsigned int i = 0; i < old_size; i++)
+        {
+            if (old_table[i])
+                thumbs_insert(table, old_table[i]);
+        }
+        core_free(thumbs.handle);
+    }
+    thumbs.handle = handle;
+    return true;
+}
+
+/* add a directory entry to the index if it is a .talk file */
+static void thumbs_add(struct dirent *entry, struct dirinfo *info)
+{
+    int ext_pos = strlen(entry->d_name) - strlen(file_thumbnail_ext);
+    if (ext_pos <= 0 /* too short to carry ".talk" */
+        || (info->attribute & ATTR_DIRECTORY) /* no file */
+        || strcasecmp(&entry->d_name[ext_pos], file_thumbnail_ext))
+        return;
+
+    /* keep the table at most half full */
+    if (++thumbs.count > (thumbs.handle > 0 ? thumbs.mask / 2 : 0) &&
+        !thumbs_grow())
+    {
+        /* no memory, scan instead */
+        thumbs.valid = thumbs.building = false;
+        thumbs.handle = core_free(thumbs.handle);
+        return;
+    }
+
+    thumbs_insert(core_get_data(thumbs.handle),
+                  thumb_hash(entry->d_name, ext_pos));
+}
+
+static bool thumbs_find(const char *name, size_t len)
+{
+    if (thumbs.handle <= 0)
+        return false; /* no .talk files at all */
+
+    const uint32_t *table = core_get_data(thumbs.handle);
+    uint32_t hash = thumb_hash(name, len);
+    unsigned int i = hash & thumbs.mask;
+
+    for (; table[i]; i = (i + 1) & thumbs.mask)
+    {
+        if (table[i] == hash)
+            return true; /* a rare false positive only costs a failed open */
+    }
+    return false;
+}
+
+/* flag the files that have a .talk thumbnail, so we don't do unsuccessful
+ * spinups later */
+static void mark_file_thumbnails(struct tree_context* c)
+{
+    if (!thumbs.valid)
+        check_file_thumbnails(c);
+    else
+    {
+        size_t ext_len = strlen(file_thumbnail_ext);
+        struct entry *entries = tree_get_entries(c);
+
+        for (int i = 0; i < c->filesindir; i++)
+        {
+            if (entries[i].attr & ATTR_DIRECTORY)
+                continue; /* we're not touching directories */
+
+            size_t len = strlen(entries[i].name);
+
+            /* .talk files speak themselves */
+            if ((len > ext_len &&
+                 !strcasecmp(&entries[i].name[len - ext_len], file_thumbnail_ext))
+                || thumbs_find(entries[i].name, len))
+                entries[i].attr |= FILE_ATTR_THUMBNAIL;
+            else
+                entries[i].attr &= ~FILE_ATTR_THUMBNAIL;
+        }
+    }
+
+    /* the next page or directory gets its own */
+    thumbs.handle = core_free(thumbs.handle);
+    thumbs.valid = false;
+}
+
+/* alphabetical part of compare(), uses the sort keys when available */
+static int compare_names(const struct entry* e1, const struct entry* e2)
+{
+    if (cmp_data.use_keys)
+    {
+        int res = strcmp(natsort_key(e1), natsort_key(e2));
+        if (res != 0)
+            return res;
+        /* else names only differ in case, leading zeros, diacritics.. */
+    }
+    int res = cmp_data._compar(e1->name, e2->name, MAX_PATH);
+    /* names which only differ in case still need a fixed order, or the
+       pages of a paged directory could overlap */
+    return res ? res : strcmp(e1->name, e2->name);
+}
+
 /* support function for qsort() */
 static int compare(const void* p1, const void* p2)
 {
@@ -275,7 +453,7 @@ static int compare(const void* p1, const void* p2)
             if (t1 != t2) /* if different */
                 return (t1 - t2) * (criteria == SORT_TYPE_REVERSED ? -1 : 1);
             /* else alphabetical sorting */
-            return cmp_data._compar(e1->name, e2->name, MAX_PATH);
+            return compare_names(e1, e2);
         }
 
         case SORT_DATE:
@@ -289,7 +467,7 @@ static int compare(const void* p1, const void* p2)
         case SORT_ALPHA:
         case SORT_ALPHA_REVERSED:
         {
-            return cmp_data._compar(e1->name, e2->name, MAX_PATH) *
+            return compare_names(e1, e2) *
                 (criteria == SORT_ALPHA_REVERSED ? -1 : 1);
         }
 
@@ -297,132 +475,296 @@ static int compare(const void* p1, const void* p2)
     return 0; /* never reached */
 }
 
-/* load and sort directory into the tree's cache. returns NULL on failure. */
-int ft_load(struct tree_context* c, const char* tempdir)
+static const char *entry_name(const void *entry)
 {
-    if (c->out_of_tree > 0) /* something else is loaded */
-        return 0;
-
-    int files_in_dir = 0;
-    int name_buffer_used = 0;
-    struct dirent *entry;
-    bool (*callback_show_item)(char *, int, struct tree_context *) = NULL;
-    DIR *dir;
+    return ((const struct entry *)entry)->name;
+}
 
-    if (!c->is_browsing)
-        c->browse = NULL;
+/* sort by natural sort keys when numbers are interpreted, if they fit */
+static void sort_entries(struct tree_context* c, int count)
+{
+    struct entry *entries = tree_get_entries(c);
 
-    if (tempdir)
-        dir = opendir(tempdir);
-    else
+    if (count > 1 &&
+        global_settings.interpret_numbers == SORT_INTERPRET_AS_NUMBER)
     {
-        dir = opendir(c->currdir);
-        callback_show_item = c->browse? c->browse->callback_show_item: NULL;
+        cmp_data.use_keys = true;
+        bool sorted = natsort_by_keys(entries, count, sizeof(struct entry),
+                                      entry_name, !global_settings.sort_case,
+                                      compare);
+        cmp_data.use_keys = false;
+        if (sorted)
+            return;
     }
-    if(!dir)
-        return -1; /* not a directory */
 
-    c->dirsindir = 0;
-    c->dirfull = false;
-
-    tree_lock_cache(c);
-    while ((entry = readdir(dir))) {
-        int len;
-        struct dirinfo info;
-        struct entry* dptr = tree_get_entry_at(c, files_in_dir);
-        if (!dptr)
-        {
-            c->dirfull = true;
-            break;
-        }
-
-        info = dir_get_info(dir, entry);
-        len = strlen((char *)entry->d_name);
+    qsort(entries, count, sizeof(struct entry), compare);
+}
 
-        /* Skip FAT volume ID */
-        if (info.attribute & ATTR_VOLUME_ID) {
-            continue;
-        }
+/* check whether a directory entry passes the current filters, sets *attr to
+ * its attributes plus the file type */
+static bool ft_show_entry(struct tree_context* c, struct dirent *entry,
+                          struct dirinfo *info, int *attr,
+                          bool (*callback_show_item)(char *, int, struct tree_context *))
+{
+    /* Skip FAT volume ID */
+    if (info->attribute & ATTR_VOLUME_ID)
+        return false;
 
-        dptr->attr = info.attribute;
-        int dir_attr = (dptr->attr & ATTR_DIRECTORY);
-        /* skip directories . and .. */
-        if (dir_attr && is_dotdir_name(entry->d_name))
-            continue;
+    int dir_attr = (info->attribute & ATTR_DIRECTORY);
+    /* skip directories . and .. */
+    if (dir_attr && is_dotdir_name(entry->d_name))
+        return false;
 
-        /* filter out dotfiles and hidden files */
-        if (*c->dirfilter != SHOW_ALL &&
-            ((entry->d_name[0]=='.') ||
-            (info.attribute & ATTR_HIDDEN))) {
-            continue;
-        }
+    /* filter out dotfiles and hidden files */
+    if (*c->dirfilter != SHOW_ALL &&
+        ((entry->d_name[0]=='.') ||
+        (info->attribute & ATTR_HIDDEN))) {
+        return false;
+    }
 
-        if (*c->dirfilter == SHOW_PLUGINS && (dptr->attr & ATTR_DIRECTORY) &&
-            (dptr->attr &
-            (ATTR_HIDDEN | ATTR_SYSTEM | ATTR_VOLUME_ID | ATTR_VOLUME)) != 0) {
-            continue; /* skip non plugin folders */
-        }
+    if (*c->dirfilter == SHOW_PLUGINS && dir_attr &&
+        (info->attribute &
+        (ATTR_HIDDEN | ATTR_SYSTEM | ATTR_VOLUME_ID | ATTR_VOLUME)) != 0) {
+        return false; /* skip non plugin folders */
+    }
 
-        /* check for known file types */
-        if ( !(dir_attr) )
-            dptr->attr |= filetype_get_attr((char *)entry->d_name);
+    *attr = info->attribute;
+    /* check for known file types */
+    if ( !(dir_attr) )
+        *attr |= filetype_get_attr((char *)entry->d_name);
 
-        int file_attr = (dptr->attr & FILE_ATTR_MASK);
+    int file_attr = (*attr & FILE_ATTR_MASK);
 
 #define CHK_FT(show,attr) (*c->dirfilter == (show) && file_attr != (attr))
-        /* filter out non-visible files */
-        if ((!(dir_attr) && (CHK_FT(SHOW_PLAYLIST, FILE_ATTR_M3U) ||
-            (CHK_FT(SHOW_MUSIC, FILE_ATTR_AUDIO) && file_attr != FILE_ATTR_M3U) ||
-            (*c->dirfilter == SHOW_SUPPORTED && !filetype_supported(dptr->attr)))) ||
-            CHK_FT(SHOW_WPS,  FILE_ATTR_WPS)  ||
-            CHK_FT(SHOW_FONT, FILE_ATTR_FONT) ||
-            CHK_FT(SHOW_SBS,  FILE_ATTR_SBS)  ||
+    /* filter out non-visible files */
+    if ((!(dir_attr) && (CHK_FT(SHOW_PLAYLIST, FILE_ATTR_M3U) ||
+        (CHK_FT(SHOW_MUSIC, FILE_ATTR_AUDIO) && file_attr != FILE_ATTR_M3U) ||
+        (*c->dirfilter == SHOW_SUPPORTED && !filetype_supported(*attr)))) ||
+        CHK_FT(SHOW_WPS,  FILE_ATTR_WPS)  ||
+        CHK_FT(SHOW_FONT, FILE_ATTR_FONT) ||
+        CHK_FT(SHOW_SBS,  FILE_ATTR_SBS)  ||
 #if CONFIG_TUNER
-            CHK_FT(SHOW_FMS, FILE_ATTR_FMS) ||
-            CHK_FT(SHOW_FMR, FILE_ATTR_FMR) ||
+        CHK_FT(SHOW_FMS, FILE_ATTR_FMS) ||
+        CHK_FT(SHOW_FMR, FILE_ATTR_FMR) ||
 #endif
 #ifdef HAVE_REMOTE_LCD
-            CHK_FT(SHOW_RWPS, FILE_ATTR_RWPS) ||
-            CHK_FT(SHOW_RSBS, FILE_ATTR_RSBS) ||
+        CHK_FT(SHOW_RWPS, FILE_ATTR_RWPS) ||
+        CHK_FT(SHOW_RSBS, FILE_ATTR_RSBS) ||
 #if CONFIG_TUNER
-            CHK_FT(SHOW_RFMS, FILE_ATTR_RFMS) ||
+        CHK_FT(SHOW_RFMS, FILE_ATTR_RFMS) ||
 #endif
 #endif
-            CHK_FT(SHOW_M3U, FILE_ATTR_M3U) ||
-            CHK_FT(SHOW_CFG, FILE_ATTR_CFG) ||
-            CHK_FT(SHOW_LNG, FILE_ATTR_LNG) ||
-            CHK_FT(SHOW_MOD, FILE_ATTR_MOD) ||
-           /* show first level directories */
-           ((!(dir_attr) || c->dirlevel > 0)       &&
-            CHK_FT(SHOW_PLUGINS, FILE_ATTR_ROCK)   &&
-                       file_attr != FILE_ATTR_LUA  &&
-                       file_attr != FILE_ATTR_OPX) ||
-            (callback_show_item && !callback_show_item(entry->d_name, dptr->attr, c)))
+        CHK_FT(SHOW_M3U, FILE_ATTR_M3U) ||
+        CHK_FT(SHOW_CFG, FILE_ATTR_CFG) ||
+        CHK_FT(SHOW_LNG, FILE_ATTR_LNG) ||
+        CHK_FT(SHOW_MOD, FILE_ATTR_MOD) ||
+       /* show first level directories */
+       ((!(dir_attr) || c->dirlevel > 0)       &&
+        CHK_FT(SHOW_PLUGINS, FILE_ATTR_ROCK)   &&
+                   file_attr != FILE_ATTR_LUA  &&
+                   file_attr != FILE_ATTR_OPX) ||
+        (callback_show_item && !callback_show_item(entry->d_name, *attr, c)))
+    {
+        return false;
+    }
+#undef CHK_FT
+
+    return true;
+}
+
+/* Directories with more visible entries than the cache can hold are paged:
+ * the cache keeps a window of the sorted directory, which starts at list
+ * position c->firstpos. A window is picked in a single pass over the
+ * directory, keeping the entries that sort next to a bound entry (the first
+ * or last entry of the window before) on a heap as long as they fit. */
+struct page_select
+{
+    int dir;                   /* 1: entries after the bound, -1: before it */
+    const struct entry *bound; /* NULL to start at either end */
+};
+
+/* true if e1 is further away from the bound than e2 */
+static inline bool page_worse(const struct page_select *sel,
+                              const struct entry *e1, const struct entry *e2)
+{
+    return sel->dir * compare(e1, e2) > 0;
+}
+
+/* restore the heap below entry i, the worst entry is on top */
+static void page_sift_down(const struct page_select *sel,
+                           struct entry *entries, int count, int i)
+{
+    while (true)
+    {
+        int worst = i, child = 2 * i + 1;
+
+        if (child < count && page_worse(sel, &entries[child], &entries[worst]))
+            worst = child;
+        if (child + 1 < count &&
+            page_worse(sel, &entries[child + 1], &entries[worst]))
+            worst = child + 1;
+        if (worst == i)
+            return;
+
+        struct entry tmp = entries[i];
+        entries[i] = entries[worst];
+        entries[worst] = tmp;
+        i = worst;
+    }
+}
+
+static void page_heapify(const struct page_select *sel,
+                         struct entry *entries, int count)
+{
+    for (int i = count / 2 - 1; i >= 0; i--)
+        page_sift_down(sel, entries, count, i);
+}
+
+/* drop the top of the heap, returns the new number of entries */
+static int page_evict(const struct page_select *sel, struct entry *entries,
+                      int count, int *name_bytes)
+{
+    *name_bytes -= strlen(entries[0].name) + 1;
+    entries[0] = entries[--count];
+    page_sift_down(sel, entries, count, 0);
+    return count;
+}
+
+static int compare_name_ptr(const void* p1, const void* p2)
+{
+    const struct entry* e1 = p1;
+    const struct entry* e2 = p2;
+    return (e1->name > e2->name) - (e1->name < e2->name);
+}
+
+/* close the gaps evicted entries left in the name buffer, the order of the
+ * entries is lost. returns the space used */
+static int page_compact_names(struct entry *entries, int count,
+                              char *name_buffer)
+{
+    int used = 0;
+
+    qsort(entries, count, sizeof(struct entry), compare_name_ptr);
+    for (int i = 0; i < count; i++)
+    {
+        int len = strlen(entries[i].name) + 1;
+        memmove(name_buffer + used, entries[i].name, len);
+        entries[i].name = name_buffer + used;
+        used += len;
+    }
+    return used;
+}
+
+/* Read the visible entries of a directory into the tree's cache. The whole
+ * directory is walked and the entries sorting closest to sel->bound are
+ * kept. The entries are left unsorted. Returns the number of visible
+ * entries. */
+static int ft_read_entries(struct tree_context* c, DIR *dir,
+                           const struct page_select *sel,
+                           bool (*callback_show_item)(char *, int, struct tree_context *))
+{
+    int files_in_dir = 0;
+    int visible = 0;
+    int name_buffer_used = 0;
+    int name_bytes = 0; /* of the entries kept, less than the above if some
+                           were evicted */
+    struct dirent *entry;
+    struct entry *entries = tree_get_entries(c);
+    char *name_buffer = core_get_data(c->cache.name_buffer_handle);
+
+    c->dirsindir = 0;
+    c->dirfull = false;
+
+    while ((entry = readdir(dir))) {
+        int len, attr;
+        struct dirinfo info = dir_get_info(dir, entry);
+
+        if (thumbs.building)
+            thumbs_add(entry, &info);
+
+        if (!ft_show_entry(c, entry, &info, &attr, callback_show_item))
+            continue;
+
+        visible++;
+        if (attr & ATTR_DIRECTORY) /* count all dirs, for talking numbers */
+            c->dirsindir++;
+
+        struct entry cand = {
+            .name = (char *)entry->d_name,
+            .attr = attr,
+            .time_write = info.mtime,
+        };
+
+        if (sel->bound && !page_worse(sel, &cand, sel->bound))
+            continue; /* on the other side of the bound */
+
+        len = strlen(cand.name);
+
+        if (!c->dirfull &&
+            files_in_dir < c->cache.max_entries &&
+            len < c->cache.name_buffer_size - name_buffer_used)
         {
+            struct entry* dptr = &entries[files_in_dir++];
+            *dptr = cand;
+            dptr->name = name_buffer + name_buffer_used;
+            strcpy(dptr->name, cand.name);
+            name_buffer_used += len + 1;
+            name_bytes += len + 1;
             continue;
         }
-#undef CHK_FT
 
-        if (len > c->cache.name_buffer_size - name_buffer_used - 1) {
+        if (!c->dirfull)
+        {
             /* Tell the world that we ran out of buffer space */
             c->dirfull = true;
-            break;
+            page_heapify(sel, entries, files_in_dir);
         }
 
-        ++files_in_dir;
+        /* only replace entries which are further away from the bound */
+        if (files_in_dir == 0 || !page_worse(sel, &entries[0], &cand))
+            continue;
 
-        dptr->name = core_get_data(c->cache.name_buffer_handle)+name_buffer_used;
-        dptr->time_write = info.mtime;
-        strcpy(dptr->name, (char *)entry->d_name);
-        name_buffer_used += len + 1;
+        /* make room by dropping the entries furthest from the bound */
+        if (files_in_dir == c->cache.max_entries)
+            files_in_dir = page_evict(sel, entries, files_in_dir, &name_bytes);
+        while (len >= c->cache.name_buffer_size - name_buffer_used)
+        {
+            if (name_bytes < name_buffer_used)
+            {
+                name_buffer_used = page_compact_names(entries, files_in_dir,
+                                                      name_buffer);
+                page_heapify(sel, entries, files_in_dir);
+            }
+            else if (files_in_dir > 0 && page_worse(sel, &entries[0], &cand))
+                files_in_dir = page_evict(sel, entries, files_in_dir,
+                                          &name_bytes);
+            else
+                break;
+        }
+        if (len >= c->cache.name_buffer_size - name_buffer_used)
+            continue; /* keep the entries closer to the bound */
 
-        if (dir_attr) /* count the remaining dirs */
-            c->dirsindir++;
+        /* sift the new entry up from the bottom of the heap */
+        int i = files_in_dir++;
+        while (i > 0 && page_worse(sel, &cand, &entries[(i - 1) / 2]))
+        {
+            entries[i] = entries[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        entries[i] = cand;
+        entries[i].name = name_buffer + name_buffer_used;
+        strcpy(entries[i].name, cand.name);
+        name_buffer_used += len + 1;
+        name_bytes += len + 1;
     }
+
     c->filesindir = files_in_dir;
-    c->dirlength = files_in_dir;
-    closedir(dir);
+    return visible;
+}
 
+/* set up compare() for the directory in the tree's cache */
+static void ft_setup_sort(struct tree_context* c)
+{
     /* allow directories to be sorted into file list */
     cmp_data.sort_dir = (*c->dirfilter == SHOW_PLUGINS) ? SORT_AS_FILE : c->sort_dir;
 
@@ -444,17 +786,279 @@ int ft_load(struct tree_context* c, const char* tempdir)
         else
             cmp_data._compar = strncasecmp;
     }
+    cmp_data.use_keys = false;
+}
 
-    qsort(tree_get_entries(c), files_in_dir, sizeof(struct entry), compare);
+/* Read the page of directory 'dirname' selected by 'sel' into the tree's
+ * cache and sort it. 'browser' tells whether it is the browser's directory,
+ * which gets filtered by its callback too. Returns the number of visible
+ * entries in the directory, -1 if it can't be opened */
+static int ft_read_page(struct tree_context* c, const char *dirname,
+                        bool browser, const struct page_select *sel)
+{
+    bool (*callback_show_item)(char *, int, struct tree_context *) =
+        (browser && c->browse) ? c->browse->callback_show_item : NULL;
+    DIR *dir = opendir(dirname);
+    if (!dir)
+        return -1;
 
-    /* If thumbnail talking is enabled, make an extra run to mark files with
-       associated thumbnails, so we don't do unsuccessful spinups later. */
+    if (dirname != pages.dir)
+        strmemccpy(pages.dir, dirname, sizeof(pages.dir));
+    pages.browser = browser;
+    pages.gen++;
+
+    tree_lock_cache(c);
+    thumbs_begin();
+    int visible = ft_read_entries(c, dir, sel, callback_show_item);
+    thumbs_end();
+    closedir(dir);
+
+    sort_entries(c, c->filesindir);
+
+    /* If thumbnail talking is enabled, mark files with associated
+       thumbnails, so we don't do unsuccessful spinups later. */
     if (global_settings.talk_file_clip)
-        check_file_thumbnails(c); /* map .talk to ours */
+        mark_file_thumbnails(c); /* map .talk to ours */
 
     tree_unlock_cache(c);
+    return visible;
+}
+
+/* load and sort directory into the tree's cache. returns NULL on failure.
+ * When a directory has more entries than the cache can hold, the whole
+ * directory is counted but only the first page is loaded, the others are
+ * loaded by ft_load_page(). */
+int ft_load(struct tree_context* c, const char* tempdir)
+{
+    if (c->out_of_tree > 0) /* something else is loaded */
+        return 0;
+
+    const struct page_select first_page = { .dir = 1, .bound = NULL };
+
+    if (!c->is_browsing)
+        c->browse = NULL;
+
+    ft_setup_sort(c);
+    int visible = ft_read_page(c, tempdir ? tempdir : c->currdir, !tempdir,
+                               &first_page);
+    if (visible < 0)
+        return -1; /* not a directory */
+
+    c->dirlength = visible;
+    c->firstpos = 0;
     return 0;
 }
+
+/* Replace the page in the cache with the next one in direction sel->dir,
+ * or the first/last page of the directory if there is no sel->bound.
+ * returns the number of entries loaded, -1 on failure */
+static int ft_load_next_page(struct tree_context* c,
+                             const struct page_select *sel)
+{
+    int first = c->firstpos;
+    int count = c->filesindir;
+    int visible = ft_read_page(c, pages.dir, pages.browser, sel);
+    if (visible < 0)
+        return -1;
+
+    c->dirlength = visible;
+    if (sel->dir > 0)
+        first = sel->bound ? first + count : 0;
+    else
+        first = (sel->bound ? first : c->dirlength) - c->filesindir;
+    c->firstpos = MAX(0, MIN(first, c->dirlength - c->filesindir));
+
+    return c->filesindir;
+}
+
+/* Load the page of a paged directory which holds list position 'index' into
+ * the tree's cache, going there page by page from the closest end or the
+ * page loaded now. returns -1 on failure. */
+int ft_load_page(struct tree_context* c, int index)
+{
+    char bound_name[MAX_PATH];
+    struct entry bound;
+    struct page_select sel;
+    int steps = 0;
+
+    ft_setup_sort(c);
+
+    while (index < c->firstpos || index >= c->firstpos + c->filesindir)
+    {
+        int last = c->firstpos + c->filesindir;
+        int bound_index = -1;
+
+        /* the directory may have changed since it was counted */
+        if (index < 0 || index >= c->dirlength || steps++ > c->dirlength)
+            return -1;
+
+        if (c->filesindir == 0)
+            sel.dir = (index < c->dirlength - index) ? 1 : -1;
+        else if (index >= last)
+        {
+            sel.dir = (index - last < c->dirlength - index) ? 1 : -1;
+            if (sel.dir > 0)
+                bound_index = c->filesindir - 1;
+        }
+        else
+        {
+            sel.dir = (index < c->firstpos - index) ? 1 : -1;
+            if (sel.dir < 0)
+                bound_index = 0;
+        }
+
+        sel.bound = NULL;
+        if (bound_index >= 0)
+        {
+            tree_lock_cache(c);
+            bound = tree_get_entries(c)[bound_index];
+            strmemccpy(bound_name, bound.name, sizeof(bound_name));
+            bound.name = bound_name;
+            sel.bound = &bound;
+            tree_unlock_cache(c);
+        }
+
+        if (ft_load_next_page(c, &sel) <= 0)
+            return -1;
+    }
+    return 0;
+}
+
+/* Returns the list position of a file in the current directory, for paged
+ * directories where it may not be loaded, -1 if it isn't there */
+int ft_get_position(struct tree_context* c, const char* name)
+{
+    char target_name[MAX_PATH];
+    struct entry target;
+    struct dirent *entry;
+    int position = 0;
+    bool found = false;
+    bool (*callback_show_item)(char *, int, struct tree_context *) =
+        c->browse? c->browse->callback_show_item: NULL;
+
+    DIR *dir = opendir(c->currdir);
+    if (!dir)
+        return -1;
+
+    ft_setup_sort(c);
+
+    while (!found && (entry = readdir(dir)))
+    {
+        struct dirinfo info = dir_get_info(dir, entry);
+        int attr;
+
+#if ((CONFIG_PLATFORM & PLATFORM_NATIVE) || defined(__APPLE__) || defined(_WIN32) || defined(__CYGWIN__))
+        if (strcasecmp(entry->d_name, name))
+#else
+        if (strcmp(entry->d_name, name))
+#endif
+            continue;
+
+        if (ft_show_entry(c, entry, &info, &attr, callback_show_item))
+        {
+            strmemccpy(target_name, entry->d_name, sizeof(target_name));
+            target.name = target_name;
+            target.attr = attr;
+            target.time_write = info.mtime;
+            found = true;
+        }
+    }
+    closedir(dir);
+
+    /* count what sorts before it */
+    if (!found || !(dir = opendir(c->currdir)))
+        return -1;
+
+    while ((entry = readdir(dir)))
+    {
+        struct dirinfo info = dir_get_info(dir, entry);
+        struct entry e;
+
+        if (!ft_show_entry(c, entry, &info, &e.attr, callback_show_item))
+            continue;
+
+        e.name = (char *)entry->d_name;
+        e.time_write = info.mtime;
+        if (compare(&e, &target) < 0)
+            position++;
+    }
+    closedir(dir);
+    return position;
+}
+
+/* load the first page of a walk, or the one after the entry it returned
+ * last. returns -1 on failure */
+static int ft_iter_load(struct tree_context* c, struct ft_iter *it)
+{
+    const struct page_select sel =
+        { .dir = 1, .bound = it->pos > 0 ? &it->entry : NULL };
+
+    ft_setup_sort(c);
+    int visible = ft_read_page(c, it->dirname, false, &sel);
+    if (visible < 0)
+        return -1;
+
+    c->dirlength = visible;
+    c->firstpos = MAX(0, MIN(it->pos, c->dirlength - c->filesindir));
+    it->gen = pages.gen;
+    it->index = 0;
+    return 0;
+}
+
+/* Walks all visible entries of 'dirname' in list order, like ft_load() with
+ * a tempdir would list them but without stopping where the cache is full.
+ * The name of each entry is copied to 'name', where the walk finds its place
+ * again if the cache was used for something else in between, like walking
+ * a subdirectory: the page after it is read in one pass over the directory
+ * instead of rescanning every page up to it. returns -1 if the directory
+ * can't be read */
+int ft_iter_init(struct tree_context* c, struct ft_iter *it,
+                 const char *dirname, char *name, size_t name_size)
+{
+    it->dirname = dirname;
+    it->entry.name = name;
+    it->name_size = name_size;
+    it->pos = 0;
+    return ft_iter_load(c, it);
+}
+
+/* back to the first entry, which only reads the directory again if its
+ * first page is gone from the cache. returns -1 on failure */
+int ft_iter_rewind(struct tree_context* c, struct ft_iter *it)
+{
+    it->pos = 0;
+    if (it->gen == pages.gen && c->firstpos == 0)
+    {
+        it->index = 0;
+        return 0;
+    }
+    return ft_iter_load(c, it);
+}
+
+/* Returns the next entry of the walk, which stays valid until the next
+ * call, or NULL at the end of the directory. Names which don't fit into the
+ * buffer end the walk too. */
+struct entry* ft_iter_next(struct tree_context* c, struct ft_iter *it)
+{
+    if (it->gen != pages.gen || it->index >= c->filesindir)
+    {
+        /* nothing comes after the last page */
+        if (it->gen == pages.gen &&
+            c->firstpos + c->filesindir >= c->dirlength)
+            return NULL;
+        if (ft_iter_load(c, it) < 0 || c->filesindir == 0)
+            return NULL;
+    }
+
+    const struct entry *entry = &tree_get_entries(c)[it->index++];
+    if (!strmemccpy(it->entry.name, entry->name, it->name_size))
+        return NULL;
+    it->entry.attr = entry->attr;
+    it->entry.time_write = entry->time_write;
+    it->pos++;
+    return &it->entry;
+}
+
 static void ft_load_font(char *file)
 {
     int current_font_id;
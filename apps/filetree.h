@@ -23,6 +23,24 @@
 #include "tree.h"
 
 int ft_load(struct tree_context* c, const char* tempdir);
+int ft_load_page(struct tree_context* c, int index);
+int ft_get_position(struct tree_context* c, const char* name);
+
+/* a walk over all entries of a directory, see ft_iter_init() */
+struct ft_iter
+{
+    const char *dirname;
+    struct entry entry; /* returned last, named in the caller's buffer */
+    size_t name_size;
+    int pos;            /* list position of the next entry */
+    int index;          /* of the next entry in the tree's cache */
+    unsigned int gen;   /* page of the cache 'index' refers to */
+};
+
+int ft_iter_init(struct tree_context* c, struct ft_iter *it,
+                 const char *dirname, char *name, size_t name_size);
+int ft_iter_rewind(struct tree_context* c, struct ft_iter *it);
+struct entry* ft_iter_next(struct tree_context* c, struct ft_iter *it);
 int ft_enter(struct tree_context* c);
 int ft_exit(struct tree_context* c);
 int ft_assemble_path(char *buf, size_t bufsz,
@@ -52,6 +52,15 @@ static long last_dirty_tick;
 static struct viewport parent[NB_SCREENS];
 static struct gui_synclist *current_lists;
 
+/* The item whose voice clips are loaded ahead of time, see list_prefetch() */
+static struct
+{
+    struct gui_synclist *list; /* the list the rest is about */
+    int last_item;             /* the item spoken last, gives the direction */
+    int item;                  /* the item to note the clips of, or -1 */
+    bool loading;              /* noted clips left to load */
+} prefetch;
+
 static bool list_is_dirty(struct gui_synclist *list)
 {
     return TIME_BEFORE(list->dirty_tick, last_dirty_tick);
@@ -183,6 +192,8 @@ void gui_synclist_init(struct gui_synclist * gui_list,
     gui_list->title_icon = Icon_NOICON;
 
     gui_list->scheduled_talk_tick = gui_list->last_talked_tick = 0;
+    if (prefetch.list == gui_list)
+        prefetch.list = NULL; /* another list in the same place */
     gui_list->dirty_tick = current_tick;
 
 #ifdef HAVE_LCD_COLOR
@@ -319,6 +330,53 @@ static void edge_beep(struct gui_synclist * gui_list, bool wrap)
     }
 }
 
+/* Pick the item after the one just spoken, in the direction the user is
+   scrolling, as the one to prefetch. */
+static void list_schedule_prefetch(struct gui_synclist *lists)
+{
+    int item = lists->selected_item + lists->selected_size;
+
+    if (prefetch.list == lists && lists->selected_item < prefetch.last_item)
+        item = lists->selected_item - lists->selected_size;
+    if (lists->wraparound)
+        item = (item + lists->nb_items) % lists->nb_items;
+
+    prefetch.list = lists;
+    prefetch.last_item = lists->selected_item;
+    prefetch.item = (item >= 0 && item < lists->nb_items) ? item : -1;
+    prefetch.loading = false;
+}
+
+static bool list_prefetch_pending(struct gui_synclist *lists)
+{
+    return prefetch.list == lists && (prefetch.item >= 0 || prefetch.loading);
+}
+
+/* Load the voice clips of the item picked by list_schedule_prefetch(), so
+   speaking it doesn't wait for the disk. The voice callback is run with
+   talk only noting what it would say. Loading can evict clips and blocks
+   the UI, so it is left until the list is idle and nothing is spoken, and
+   done one clip at a time. */
+static void list_prefetch(struct gui_synclist *lists)
+{
+    if (!list_prefetch_pending(lists) || lists->scheduled_talk_tick ||
+        is_voice_queued())
+        return;
+
+    if (prefetch.item >= 0)
+    {
+        if (prefetch.item < lists->nb_items && lists->callback_speak_item)
+        {
+            talk_prefetch_begin();
+            lists->callback_speak_item(prefetch.item, lists->data);
+            talk_prefetch_end();
+        }
+        prefetch.item = -1;
+    }
+
+    prefetch.loading = talk_prefetch_next();
+}
+
 static void _gui_synclist_speak_item(struct gui_synclist *lists)
 {
     list_speak_item *cb = lists->callback_speak_item;
@@ -341,6 +399,7 @@ static void _gui_synclist_speak_item(struct gui_synclist *lists)
             lists->scheduled_talk_tick = 0; /* work done */
             cb(lists->selected_item, lists->data);
             lists->last_talked_tick = current_tick;
+            list_schedule_prefetch(lists);
         }
     }
 }
@@ -783,12 +842,15 @@ bool gui_synclist_do_button(struct gui_synclist * lists, int *actionptr)
        && TIME_AFTER(current_tick, lists->scheduled_talk_tick))
         /* scheduled postponed item announcement is due */
         _gui_synclist_speak_item(lists);
+    else if (action == ACTION_NONE)
+        list_prefetch(lists);
     return false;
 }
 
 int list_do_action_timeout(struct gui_synclist *lists, int timeout)
 /* Returns the lowest of timeout or the delay until a postponed
-   scheduled announcement is due (if any). */
+   scheduled announcement is due (if any), or a short one while voice
+   clips wait to be prefetched. */
 {
     add_event_ex(GUI_EVENT_NEED_UI_UPDATE, true, _lists_uiviewport_update_callback, NULL);
     current_lists = lists;
@@ -802,6 +864,12 @@ int list_do_action_timeout(struct gui_synclist *lists, int timeout)
         if(timeout > delay || timeout == TIMEOUT_BLOCK)
             timeout = delay;
     }
+    else if(list_prefetch_pending(lists))
+    {
+        /* come back to load the clips once the voice is done */
+        if(timeout > HZ/10 || timeout == TIMEOUT_BLOCK)
+            timeout = HZ/10;
+    }
     return timeout;
 }
 
@@ -85,5 +85,10 @@ void skin_request_full_update(enum skinnable_screens skin);
 
 bool dbg_skin_engine(void);
 
+#ifdef SIMULATOR
+/* render a skin without a window, set up by --renderskin */
+int skin_render_headless(void);
+#endif
+
 #endif /* !PLUGIN */
 #endif
@@ -0,0 +1,295 @@
+/***************************************************************************
+ *             __________               __   ___.
+ *   Open      \______   \ ____   ____ |  | _\_ |__   _______  ___
+ *   Source     |       _//  _ \_/ ___\|  |/ /| __ \ /  _ \  \/  /
+ *   Jukebox    |    |   (  <_> )  \___|    < | \_\ (  <_> > <  <
+ *   Firmware   |____|_  /\____/ \___  >__|_ \|___  /\____/__/\_ \
+ *                     \/            \/     \/    \/            \/
+ * $Id$
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF ANY
+ * KIND, either express or implied.
+ *
+ ****************************************************************************/
+
+/* Headless WPS rendering for the simulator.
+ *
+ * "rockboxui --renderskin /.rockbox/wps/foo.wps" loads the skin, renders
+ * --frames frames of it with a scripted track and exits. All paths are in
+ * the simulated disk. Nothing is shown, so it runs as fast as skin_render()
+ * and the lcd drivers allow, which makes it usable as a benchmark.
+ *
+ * --dumpdir saves every frame as frameNNNN.bmp. --refdir compares the
+ * frames against the ones in an earlier --dumpdir and counts the pixels
+ * which changed. The exit status is non zero if any frame differs, so
+ * a set of reference dumps works as a regression test. Only the
+ * skin_render() calls are timed, not the dumps or the comparisons.
+ *
+ * The --track file holds "name: value" lines like a .cfg file:
+ *   title, artist, album, albumartist, composer, genre, comment, grouping,
+ *   path, year, track, disc, bitrate, frequency (Hz),
+ *   length, elapsed and step (all in ms).
+ * Every frame moves the elapsed time on by step.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "string-extra.h"
+#include "file.h"
+#include "dir.h"
+#include "kernel.h"
+#include "system.h"
+#include "misc.h"
+#include "screendump.h"
+#include "screen_access.h"
+#include "metadata.h"
+#include "wps.h"
+#include "wps_internals.h"
+#include "skin_engine.h"
+
+void skin_render(struct gui_wps *gwps, unsigned refresh_mode);
+
+/* where frames go for comparing when they aren't kept */
+#define RENDER_SCRATCH_FILE ROCKBOX_DIR "/render.bmp"
+
+static struct mp3entry render_id3;
+static unsigned long render_step = 1000;
+
+/* copy a tag value into the id3v2 buffer of the track */
+static char* render_string(const char *value, size_t *used)
+{
+    char *str = &render_id3.id3v2buf[*used];
+    size_t len = strlen(value) + 1;
+
+    if (*used + len > sizeof(render_id3.id3v2buf))
+        return NULL;
+    memcpy(str, value, len);
+    *used += len;
+    return str;
+}
+
+static void render_load_track(const char *filename)
+{
+    char line[MAX_PATH];
+    char *name, *value;
+    size_t used = 0;
+    int fd;
+
+    memset(&render_id3, 0, sizeof(render_id3));
+    render_id3.title = "Title";
+    render_id3.artist = "Artist";
+    render_id3.album = "Album";
+    render_id3.length = 4 * 60 * 1000;
+    render_id3.bitrate = 320;
+    render_id3.frequency = 44100;
+    render_id3.codectype = AFMT_MPA_L3;
+    strcpy(render_id3.path, "/Music/Artist/Album/01 Title.mp3");
+
+    if (!filename)
+        return;
+    fd = open_utf8(filename, O_RDONLY);
+    if (fd < 0)
+    {
+        printf("Can't open track file %s\n", filename);
+        return;
+    }
+
+    while (read_line(fd, line, sizeof(line)) > 0)
+    {
+        if (!settings_parseline(line, &name, &value))
+            continue;
+
+        if (!strcmp(name, "title"))
+            render_id3.title = render_string(value, &used);
+        else if (!strcmp(name, "artist"))
+            render_id3.artist = render_string(value, &used);
+        else if (!strcmp(name, "album"))
+            render_id3.album = render_string(value, &used);
+        else if (!strcmp(name, "albumartist"))
+            render_id3.albumartist = render_string(value, &used);
+        else if (!strcmp(name, "composer"))
+            render_id3.composer = render_string(value, &used);
+        else if (!strcmp(name, "genre"))
+            render_id3.genre_string = render_string(value, &used);
+        else if (!strcmp(name, "comment"))
+            render_id3.comment = render_string(value, &used);
+        else if (!strcmp(name, "grouping"))
+            render_id3.grouping = render_string(value, &used);
+        else if (!strcmp(name, "path"))
+            strmemccpy(render_id3.path, value, sizeof(render_id3.path));
+        else if (!strcmp(name, "year"))
+        {
+            render_id3.year = atoi(value);
+            render_id3.year_string = render_string(value, &used);
+        }
+        else if (!strcmp(name, "track"))
+        {
+            render_id3.tracknum = atoi(value);
+            render_id3.track_string = render_string(value, &used);
+        }
+        else if (!strcmp(name, "disc"))
+        {
+            render_id3.discnum = atoi(value);
+            render_id3.disc_string = render_string(value, &used);
+        }
+        else if (!strcmp(name, "bitrate"))
+            render_id3.bitrate = atoi(value);
+        else if (!strcmp(name, "frequency"))
+            render_id3.frequency = atoi(value);
+        else if (!strcmp(name, "length"))
+            render_id3.length = atoi(value);
+        else if (!strcmp(name, "elapsed"))
+            render_id3.elapsed = atoi(value);
+        else if (!strcmp(name, "step"))
+            render_step = atoi(value);
+    }
+    close(fd);
+}
+
+/* Count the pixels which differ between two screen dumps,
+ * -1 if they can't be compared */
+static long render_compare(const char *file, const char *ref)
+{
+    unsigned char line[DUMP_BMP_LINESIZE], refline[DUMP_BMP_LINESIZE];
+    /* file and info header, the palette is the same for all dumps */
+    unsigned char header[54], refheader[54];
+    long diff = 0;
+    int fd, reffd, x;
+
+    fd = open(file, O_RDONLY);
+    reffd = open(ref, O_RDONLY);
+    if (fd < 0 || reffd < 0 ||
+        filesize(fd) != filesize(reffd) ||
+        read(fd, header, sizeof(header)) != sizeof(header) ||
+        read(reffd, refheader, sizeof(refheader)) != sizeof(refheader) ||
+        memcmp(header, refheader, sizeof(header)))
+    {
+        diff = -1;
+        goto out;
+    }
+
+    /* the pixel data starts at the offset in the file header */
+    lseek(fd, load_le32(&header[10]), SEEK_SET);
+    lseek(reffd, load_le32(&refheader[10]), SEEK_SET);
+
+    while (read(fd, line, sizeof(line)) == sizeof(line) &&
+           read(reffd, refline, sizeof(refline)) == sizeof(refline))
+    {
+        if (!memcmp(line, refline, sizeof(line)))
+            continue;
+        for (x = 0; x < LCD_WIDTH; x++)
+        {
+#if DUMP_BMP_BPP == 4
+            unsigned shift = (x & 1) ? 0 : 4;
+            if (((line[x/2] ^ refline[x/2]) >> shift) & 0xf)
+                diff++;
+#else
+            const int size = DUMP_BMP_BPP / 8;
+            if (memcmp(&line[x*size], &refline[x*size], size))
+                diff++;
+#endif
+        }
+    }
+
+out:
+    if (fd >= 0)
+        close(fd);
+    if (reffd >= 0)
+        close(reffd);
+    return diff;
+}
+
+/* render the skin as set up on the command line, returns the exit status */
+int skin_render_headless(void)
+{
+    struct gui_wps *gwps = skin_get_gwps(WPS, SCREEN_MAIN);
+    struct wps_state *state = get_wps_state();
+    char filename[MAX_PATH], refname[MAX_PATH];
+    int frame, changed = 0, missing = 0;
+    uint64_t start, usec = 0;
+
+    if (!skin_data_load(SCREEN_MAIN, gwps->data, sim_render_skin, true,
+                        skin_get_stats(WPS, SCREEN_MAIN)))
+    {
+        printf("%s: failed to load the skin\n", sim_render_skin);
+        return 1;
+    }
+#ifdef HAVE_BACKDROP_IMAGE
+    skin_backdrops_preload();
+#endif
+
+    render_load_track(sim_render_track);
+    state->id3 = &render_id3;
+    state->nid3 = NULL;
+    state->paused = false;
+    state->ff_rewind_count = 0;
+
+    if (sim_render_dumpdir && !dir_exists(sim_render_dumpdir))
+        mkdir(sim_render_dumpdir);
+
+    push_current_activity(ACTIVITY_WPS);
+    screens[SCREEN_MAIN].clear_display();
+
+    for (frame = 0; frame < sim_render_frames; frame++)
+    {
+        start = sim_get_usec();
+        skin_render(gwps, frame == 0 ? SKIN_REFRESH_ALL
+                                     : SKIN_REFRESH_NON_STATIC);
+        usec += sim_get_usec() - start;
+
+        if (sim_render_dumpdir)
+        {
+            snprintf(filename, sizeof(filename), "%s/frame%04d.bmp",
+                     sim_render_dumpdir, frame);
+            screen_dump_file(filename);
+        }
+        else if (sim_render_refdir)
+        {
+            strcpy(filename, RENDER_SCRATCH_FILE);
+            screen_dump_file(filename);
+        }
+
+        if (sim_render_refdir)
+        {
+            long diff;
+            snprintf(refname, sizeof(refname), "%s/frame%04d.bmp",
+                     sim_render_refdir, frame);
+            diff = render_compare(filename, refname);
+            if (diff < 0)
+            {
+                printf("frame %d: no reference to compare to\n", frame);
+                missing++;
+            }
+            else if (diff > 0)
+            {
+                printf("frame %d: %ld pixels changed\n", frame, diff);
+                changed++;
+            }
+        }
+
+        render_id3.elapsed += render_step;
+        if (render_id3.elapsed > render_id3.length)
+            render_id3.elapsed = 0;
+    }
+    pop_current_activity_without_refresh();
+
+    if (sim_render_refdir && !sim_render_dumpdir)
+        remove(RENDER_SCRATCH_FILE);
+
+    printf("%s: %d frames rendered in %lu us", sim_render_skin,
+           sim_render_frames, (unsigned long)usec);
+    if (usec > 0)
+        printf(", %lu frames per second",
+               (unsigned long)(sim_render_frames * 1000000ull / usec));
+    printf("\n");
+    if (sim_render_refdir)
+        printf("%d frames changed, %d without reference\n", changed, missing);
+
+    return (changed || missing) ? 1 : 0;
+}
@@ -319,6 +319,7 @@ static int parse_image_display(struct skin_element *element,
                                struct wps_data *wps_data)
 {
     char *label = get_param_text(element, 0);
+    char shortlabel[2];
     char sublabel = '\0';
     int subimage;
     struct gui_img *img;
@@ -326,9 +327,12 @@ static int parse_image_display(struct skin_element *element,
 
     if (element->params_count == 1 && strlen(label) <= 2)
     {
-        /* backwards compatability. Allow %xd(Aa) to still work */
+        /* backwards compatability. Allow %xd(Aa) to still work.
+         * The parser shares equal strings, so don't cut the label in place */
         sublabel = label[1];
-        label[1] = '\0';
+        shortlabel[0] = label[0];
+        shortlabel[1] = '\0';
+        label = shortlabel;
     }
     /* sanity check */
     img = skin_find_item(label, SKIN_FIND_IMAGE, wps_data);
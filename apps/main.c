@@ -180,6 +180,14 @@ int main(void)
     }
     list_init();
     tree_init();
+#ifdef SIMULATOR
+    if (sim_render_skin)
+    {
+        /* shut down like any other exit, with the result as exit status */
+        sim_exit_status = skin_render_headless();
+        power_off();
+    }
+#endif
 #if defined(HAVE_DEVICEDATA) && !defined(BOOTLOADER) /* SIMULATOR */
     verify_device_data();
 #endif
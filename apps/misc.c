@@ -102,6 +102,7 @@
 #ifndef PLUGIN
 #include "core_alloc.h" /*core_load_bmp()*/
 #endif
+#include "strnatcmp.h"
 
 #ifdef HAVE_HARDWARE_CLICK
 #include "piezo.h"
@@ -1913,6 +1914,76 @@ int core_load_bmp(const char * filename, struct bitmap *bm, const int bmformat,
     return handle;
 }
 
+/* Precedes each copy natsort_by_keys() sorts, sized so the copy stays
+ * aligned for any type */
+union natsort_head
+{
+    const char *key;
+    intmax_t align;
+};
+
+static int (*natsort_compar)(const void *, const void *);
+
+static int natsort_compare(const void *p1, const void *p2)
+{
+    return natsort_compar((const union natsort_head *)p1 + 1,
+                          (const union natsort_head *)p2 + 1);
+}
+
+/* Natural sort key of an element passed to the natsort_by_keys() callback */
+const char *natsort_key(const void *elem)
+{
+    return ((const union natsort_head *)elem)[-1].key;
+}
+
+/* Natural sorting re-parses numbers on every comparison, which gets slow for
+ * big lists. If there is enough free memory, build a strnatkey() for every
+ * name once and qsort() copies of the elements with compar, which can get
+ * the keys with natsort_key(). Returns false, leaving the elements alone,
+ * if the keys don't fit. */
+bool natsort_by_keys(void *base, int count, size_t size,
+                     const char *(*get_name)(const void *elem),
+                     bool ignore_case,
+                     int (*compar)(const void *, const void *))
+{
+    size_t rec_size = sizeof(union natsort_head) +
+                      ALIGN_UP(size, sizeof(union natsort_head));
+    size_t alloc_size = count * rec_size;
+    char *elem;
+    char *rec, *key;
+    int handle;
+    int i;
+
+    for (i = 0, elem = base; i < count; i++, elem += size)
+        alloc_size += strnatkey(NULL, get_name(elem), ignore_case);
+
+    /* don't make anyone shrink their buffers just to sort faster */
+    if (alloc_size > core_allocatable())
+        return false;
+    handle = core_alloc_ex(alloc_size, &buflib_ops_locked);
+    if (handle <= 0)
+        return false;
+
+    rec = core_get_data(handle);
+    key = rec + count * rec_size;
+    for (i = 0, elem = base; i < count; i++, elem += size, rec += rec_size)
+    {
+        ((union natsort_head *)rec)->key = key;
+        memcpy(rec + sizeof(union natsort_head), elem, size);
+        key += strnatkey(key, get_name(elem), ignore_case);
+    }
+
+    rec = core_get_data(handle);
+    natsort_compar = compar;
+    qsort(rec, count, rec_size, natsort_compare);
+
+    for (i = 0, elem = base; i < count; i++, elem += size, rec += rec_size)
+        memcpy(elem, rec + sizeof(union natsort_head), size);
+
+    core_free(handle);
+    return true;
+}
+
 /*
  * Normalized volume routines adapted from alsamixer volume_mapping.c
  */
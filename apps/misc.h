@@ -280,6 +280,14 @@ enum core_load_bmp_error
 struct buflib_callbacks;
 int core_load_bmp(const char *filename, struct bitmap *bm, const int bmformat,
                   ssize_t *buf_reqd, struct buflib_callbacks *ops);
+
+/* qsort() an array by the natural sort keys of its elements' names, false
+ * if there isn't enough memory for the keys */
+bool natsort_by_keys(void *base, int count, size_t size,
+                     const char *(*get_name)(const void *elem),
+                     bool ignore_case,
+                     int (*compar)(const void *, const void *));
+const char *natsort_key(const void *elem);
 #endif
 
 /* Convert a volume (in tenth dB) in the range [min_vol, max_vol]
@@ -775,54 +775,47 @@ exit:
 
 /*
  * Checks if there are any music files in the dir or any of its
- * subdirectories.  May be called recursively.
+ * subdirectories.  May be called recursively. 'dir' is a MAX_PATH buffer
+ * and holds the directory with music on success.
+ *
+ * The names of the entries are read right behind the path, so a separator
+ * in between turns 'dir' into the path of an entry, without a path buffer
+ * on the stack of every level. The root is walked as "" for that.
  */
-static int check_subdir_for_music(char *dir, const char *subdir, bool recurse)
+static int check_subdir_for_music(char *dir, bool recurse)
 {
     int result = -1;
     size_t dirlen = strlen(dir);
-    int num_files = 0;
-    int i;
-    struct entry *files;
-    bool has_music = false;
+    struct ft_iter iter;
+    struct entry *file;
     bool has_subdir = false;
     struct tree_context* tc = tree_get_context();
 
-    if (path_append(dir + dirlen, PA_SEP_HARD, subdir, MAX_PATH - dirlen) >=
-            MAX_PATH - dirlen)
-    {
-        return 0;
-    }
+    if (dirlen == 1 && dir[0] == PATH_SEPCH)
+        dirlen = 0;
+    dir[dirlen] = '\0';
 
-    if (ft_load(tc, dir) < 0)
+    if (ft_iter_init(tc, &iter, dirlen ? dir : PATH_ROOTSTR,
+                     dir + dirlen + 1, MAX_PATH - dirlen - 1) < 0)
     {
-        return -2;
+        result = -2;
+        goto out;
     }
 
-    tree_lock_cache(tc);
-    files = tree_get_entries(tc);
-    num_files = tc->filesindir;
-
-    for (i=0; i<num_files; i++)
+    while ((file = ft_iter_next(tc, &iter)))
     {
-        if (files[i].attr & ATTR_DIRECTORY)
+        if (file->attr & ATTR_DIRECTORY)
             has_subdir = true;
-        else if ((files[i].attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
+        else if ((file->attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
         {
-            has_music = true;
-            break;
+            result = 0;
+            goto out;
         }
     }
 
-    if (has_music)
+    if (has_subdir && recurse && ft_iter_rewind(tc, &iter) >= 0)
     {
-        tree_unlock_cache(tc);
-        return 0;
-    }
-
-    if (has_subdir && recurse)
-    {
-        for (i=0; i<num_files; i++)
+        while ((file = ft_iter_next(tc, &iter)))
         {
             if (action_userabort(TIMEOUT_NOBLOCK))
             {
@@ -830,31 +823,22 @@ static int check_subdir_for_music(char *dir, const char *subdir, bool recurse)
                 break;
             }
 
-            if (files[i].attr & ATTR_DIRECTORY)
+            if (file->attr & ATTR_DIRECTORY)
             {
-                result = check_subdir_for_music(dir, files[i].name, true);
+                dir[dirlen] = PATH_SEPCH;
+                result = check_subdir_for_music(dir, true);
                 if (!result)
-                    break;
+                    return 0;
+                dir[dirlen] = '\0';
             }
         }
     }
-    tree_unlock_cache(tc);
-
-    if (result < 0)
-    {
-        if (dirlen)
-        {
-            dir[dirlen] = '\0';
-        }
-        else
-        {
-            strcpy(dir, PATH_ROOTSTR);
-        }
 
-        /* we now need to reload our current directory */
-        if(ft_load(tc, dir) < 0)
-            splash(HZ*2, ID2P(LANG_PLAYLIST_DIRECTORY_ACCESS_ERROR));
-    }
+out:
+    if (dirlen)
+        dir[dirlen] = '\0';
+    else
+        strcpy(dir, PATH_ROOTSTR);
     return result;
 }
 
@@ -866,6 +850,7 @@ static int get_next_dir(char *dir, int direction)
 {
     struct playlist_info* playlist = &current_playlist;
     int result = -1;
+    char buffer[MAX_PATH];
     char *start_dir = NULL;
     bool exit = false;
     struct tree_context* tc = tree_get_context();
@@ -902,7 +887,6 @@ static int get_next_dir(char *dir, int direction)
             ssize_t nread = read(fd,&folder_count,sizeof(int));
             if ((nread == sizeof(int)) && folder_count)
             {
-                char buffer[MAX_PATH];
                 /* give up looking for a directory after we've had four
                    times as many tries as there are directories. */
                 unsigned long allowed_tries = folder_count * 4;
@@ -917,7 +901,7 @@ static int get_next_dir(char *dir, int direction)
                     read(fd, buffer, MAX_PATH);
                     /* is the current dir within our base dir and has music? */
                     if ((base_len == 0 || !strncmp(buffer, dir, base_len))
-                        && check_subdir_for_music(buffer, "", false) == 0)
+                        && check_subdir_for_music(buffer, false) == 0)
                             exit = true;
                 }
                 close(fd);
@@ -962,22 +946,20 @@ static int get_next_dir(char *dir, int direction)
 
     while (!exit)
     {
-        struct entry *files;
-        int num_files = 0;
-        int i;
+        struct ft_iter iter;
+        struct entry *file;
+        size_t dirlen = strlen(dir);
 
-        if (ft_load(tc, (dir[0]=='\0')?"/":dir) < 0)
+        /* names are read behind the path, see check_subdir_for_music() */
+        if (ft_iter_init(tc, &iter, dirlen ? dir : PATH_ROOTSTR,
+                         dir + dirlen + 1, MAX_PATH - dirlen - 1) < 0)
         {
             exit = true;
             result = -1;
             break;
         }
 
-        tree_lock_cache(tc);
-        files = tree_get_entries(tc);
-        num_files = tc->filesindir;
-
-        for (i=0; i<num_files; i++)
+        while ((file = ft_iter_next(tc, &iter)))
         {
             /* user abort */
             if (action_userabort(TIMEOUT_NOBLOCK))
@@ -987,22 +969,23 @@ static int get_next_dir(char *dir, int direction)
                 break;
             }
 
-            if (files[i].attr & ATTR_DIRECTORY)
+            if (file->attr & ATTR_DIRECTORY)
             {
                 if (!start_dir)
                 {
-                    result = check_subdir_for_music(dir, files[i].name, true);
+                    dir[dirlen] = PATH_SEPCH;
+                    result = check_subdir_for_music(dir, true);
                     if (result != -1)
                     {
                         exit = true;
                         break;
                     }
+                    dir[dirlen] = '\0';
                 }
-                else if (!strcmp(start_dir, files[i].name))
+                else if (!strcmp(start_dir, file->name))
                     start_dir = NULL;
             }
         }
-        tree_unlock_cache(tc);
 
         if (!exit)
         {
@@ -1010,7 +993,7 @@ static int get_next_dir(char *dir, int direction)
                check whether that contains music */
             if (strlen(dir) <= base_len)
             {
-                result = check_subdir_for_music(dir, "", true);
+                result = check_subdir_for_music(dir, true);
                 if (result == -1)
                     /* there's no music files in the base directory,
                        treat as a fatal error */
@@ -1025,7 +1008,9 @@ static int get_next_dir(char *dir, int direction)
                 if (start_dir)
                 {
                     *start_dir = '\0';
-                    start_dir++;
+                    /* the names of the parent's entries are read to where
+                       this one is now */
+                    start_dir = strcpy(buffer, start_dir + 1);
                 }
                 else
                     break;
@@ -1152,7 +1137,17 @@ static int create_and_play_dir(int direction, bool play_last)
 
     if (playlist_create(dir, NULL) != -1)
     {
-        ft_build_playlist(tree_get_context(), 0);
+        struct tree_context* tc = tree_get_context();
+        int dirfilter = *(tc->dirfilter);
+
+        /* The cache holds the page of dir where the music was found. Pages
+           of a directory too big for it are read again from the first one,
+           with the filter it was counted with */
+        *(tc->dirfilter) = SHOW_ALL;
+        if (tc->dirlength > tc->filesindir)
+            ft_load(tc, dir);
+        ft_build_playlist(tc, 0);
+        *(tc->dirfilter) = dirfilter;
 
         if (global_settings.playlist_shuffle)
              playlist_shuffle(current_tick, -1);
@@ -2191,32 +2186,36 @@ int playlist_directory_tracksearch(const char* dirname, bool recurse,
 {
     char buf[MAX_PATH+1];
     int result = 0;
-    int num_files = 0;
-    int i;;
+    size_t len;
+    struct ft_iter iter;
+    struct entry *file;
     struct tree_context* tc = tree_get_context();
-    struct tree_cache* cache = &tc->cache;
     int old_dirfilter = *(tc->dirfilter);
 
     if (!callback)
         return -1;
 
+    /* the names are read right behind the directory, which makes buf the
+       path of each entry */
+    len = path_append(buf, dirname, NULL, sizeof(buf));
+    if (len >= sizeof(buf))
+        return 0;
+
     /* use the tree browser dircache to load files */
     *(tc->dirfilter) = SHOW_ALL;
 
-    if (ft_load(tc, dirname) < 0)
+    if (ft_iter_init(tc, &iter, dirname, buf + len, sizeof(buf) - len) < 0)
     {
         splash(HZ*2, ID2P(LANG_PLAYLIST_DIRECTORY_ACCESS_ERROR));
         *(tc->dirfilter) = old_dirfilter;
         return -1;
     }
 
-    num_files = tc->filesindir;
-
     /* we've overwritten the dircache so tree browser will need to be
        reloaded */
     reload_directory();
 
-    for (i=0; i<num_files; i++)
+    while ((file = ft_iter_next(tc, &iter)))
     {
         /* user abort */
         if (action_userabort(TIMEOUT_NOBLOCK))
@@ -2225,48 +2224,20 @@ int playlist_directory_tracksearch(const char* dirname, bool recurse,
             break;
         }
 
-        struct entry *files = core_get_data(cache->entries_handle);
-        if (files[i].attr & ATTR_DIRECTORY)
+        if (file->attr & ATTR_DIRECTORY)
         {
             if (recurse)
             {
-                /* recursively add directories */
-                if (path_append(buf, dirname, files[i].name, sizeof(buf))
-                        >= sizeof(buf))
-                {
-                    continue;
-                }
-
+                /* recursively add directories, the walk here goes on
+                   after it without reading everything before it again */
                 result = playlist_directory_tracksearch(buf, recurse,
                     callback, context);
                 if (result < 0)
                     break;
-
-                /* we now need to reload our current directory */
-                if(ft_load(tc, dirname) < 0)
-                {
-                    result = -1;
-                    break;
-                }
-
-                num_files = tc->filesindir;
-                if (!num_files)
-                {
-                    result = -1;
-                    break;
-                }
             }
-            else
-                continue;
         }
-        else if ((files[i].attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
+        else if ((file->attr & FILE_ATTR_MASK) == FILE_ATTR_AUDIO)
         {
-            if (path_append(buf, dirname, files[i].name, sizeof(buf))
-                    >= sizeof(buf))
-            {
-                continue;
-            }
-
             if (callback(buf, context) != 0)
             {
                 result = -1;
@@ -43,6 +43,7 @@
 #include "pcmbuf.h"
 #include "errno.h"
 #include "diacritic.h"
+#include "strnatcmp.h"
 #include "pathfuncs.h"
 #include "load_code.h"
 #include "file.h"
@@ -845,6 +846,10 @@ static const struct plugin_api rockbox_api = {
     add_playbacklog,
     &device_battery_tables,
     yesno_pop_confirm,
+    mixer_set_output_tap,
+    mixer_get_output_tap_pos,
+    strnatkey,
+    strnatcasecmp,
 };
 
 static int plugin_buffer_handle;
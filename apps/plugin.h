@@ -176,7 +176,7 @@ int plugin_open(const char *plugin, const char *parameter);
  * when this happens please take the opportunity to sort in
  * any new functions "waiting" at the end of the list.
  */
-#define PLUGIN_API_VERSION 274
+#define PLUGIN_API_VERSION 278
 
 /* 239 Marks the removal of ARCHOS HWCODEC and CHARCELL */
 
@@ -994,6 +994,10 @@ struct plugin_api {
     void (*add_playbacklog)(struct mp3entry *id3);
     struct battery_tables_t *device_battery_tables;
     bool (*yesno_pop_confirm)(const char* text);
+    void (*mixer_set_output_tap)(void *buf, size_t size);
+    unsigned long (*mixer_get_output_tap_pos)(void);
+    size_t (*strnatkey)(char *key, const char *str, bool ignore_case);
+    int (*strnatcasecmp)(const char *a, const char *b);
 };
 
 /* plugin header */
@@ -142,7 +142,8 @@ struct kiss_fft_state{
 #define  kf_cexp_round(x, k, n) \
 	do{ \
 		int32_t div = Q_DIV( (k) << 16, (n) << 16, 16 ) + (1 << 15); \
-		long cos, sin = fp_sincos(div << 16, &cos); \
+		/* phase is pi*(k/n + .5): half a turn per unit of div */ \
+		long cos, sin = fp_sincos(div << 15, &cos); \
 		(x)->r = ( Q_MUL(SAMP_MAX << 16, cos >> 15, 16) ) >> 16; \
 		(x)->i = ( Q_MUL(SAMP_MAX << 16, -1*(sin >> 15), 16) ) >> 16; \
 	}while(0)
@@ -84,10 +84,13 @@ static const struct button_mapping *plugin_contexts[] = { pla_main_ctx };
 #endif
 
 #define ARRAYLEN_IN (FFT_SIZE)
-#define ARRAYLEN_OUT (FFT_SIZE)
-#define ARRAYLEN_PLOT (FFT_SIZE/2-1) /* FFT is symmetric, ignore DC */
-#define BUFSIZE_FFT (sizeof(struct kiss_fft_state)+\
-                     sizeof(kiss_fft_cpx)*(FFT_SIZE-1))
+#define ARRAYLEN_OUT (FFT_SIZE/2+1) /* real input: DC to Nyquist only */
+#define ARRAYLEN_PLOT (FFT_SIZE/2-1) /* ignore DC and Nyquist */
+#define ARRAYLEN_TAP (FFT_SIZE*2) /* power of 2, room for a window and more */
+#define BUFSIZE_FFT (sizeof(struct kiss_fftr_state)+\
+                     sizeof(struct kiss_fft_state)+\
+                     sizeof(kiss_fft_cpx)*(FFT_SIZE/2-1)+\
+                     sizeof(kiss_fft_cpx)*(FFT_SIZE/2*3/2))
 
 #define __COEFF(type,size) type##_##size
 #define _COEFF(x, y) __COEFF(x,y) /* force CPP evaluation of FFT_SIZE */
@@ -100,9 +103,14 @@ static const struct button_mapping *plugin_contexts[] = { pla_main_ctx };
 #define CACHEALIGN_UP_SIZE(type, len) \
     (CACHEALIGN_UP((len)*sizeof(type) + (sizeof(type)-1)) / sizeof(type))
 /* Shared */
-/* COP + CPU PCM */
-static kiss_fft_cpx input[CACHEALIGN_UP_SIZE(kiss_fft_scalar, ARRAYLEN_IN)]
+/* CPU PCM -> COP: the mixer copies each output frame in here, whole
+   samples at a time, so keep it word-aligned */
+static int16_t pcm_tap[ARRAYLEN_TAP*2] SHAREDBSS_ATTR
+                                       CACHEALIGN_AT_LEAST_ATTR(4);
+/* COP */
+static kiss_fft_scalar input[CACHEALIGN_UP_SIZE(kiss_fft_scalar, ARRAYLEN_IN)]
                             CACHEALIGN_AT_LEAST_ATTR(4);
+static unsigned long input_tap_pos = 0; /* tap position of last transform */
 /* CPU+COP */
 #if NUM_CORES > 1
 /* Output queue indexes */
@@ -121,7 +129,7 @@ static kiss_fft_cpx output[1][ARRAYLEN_OUT];
 
 /* Unshared */
 /* COP */
-static kiss_fft_cfg fft_state SHAREDBSS_ATTR;
+static kiss_fftr_cfg fft_state SHAREDBSS_ATTR;
 static char fft_buffer[CACHEALIGN_UP_SIZE(char, BUFSIZE_FFT)]
                 CACHEALIGN_AT_LEAST_ATTR(4);
 /* CPU */
@@ -263,6 +271,8 @@ enum fft_setting_flags
 #define QLOG_MAX 0x0009154B
 /* Fudge it a little or it's not very visbile */
 #define QLIN_MAX (0x00002266 >> 1)
+/* 16*ln(2) in s15.16 */
+#define LN2_16   0x000B1721
 
 static struct fft_config fft;
 typedef void (* fft_drawfn_t)(unsigned, unsigned);
@@ -286,21 +296,6 @@ static long fft_next_frame_tick = 0; /* next tick to attempt drawing */
 
 /***************************** Math functions ******************************/
 
-/* Apply window function to input */
-static void apply_window_func(enum fft_window_func mode)
-{
-    static const int16_t * const coefs[] =
-    {
-        [FFT_WF_HAMMING] = HAMMING_COEFF,
-        [FFT_WF_HANN]    = HANN_COEFF,
-    };
-
-    const int16_t * const c = coefs[mode];
-
-    for(int i = 0; i < ARRAYLEN_IN; ++i)
-        input[i].r = (input[i].r * c[i] + 16384) >> 15;
-}
-
 /* Calculates the magnitudes from complex numbers and returns the maximum */
 static unsigned calc_magnitudes(enum fft_amp_scale scale)
 {
@@ -328,18 +323,9 @@ static unsigned calc_magnitudes(enum fft_amp_scale scale)
 
             if(scale == FFT_AS_LOG)
             {
-                if(d < 0x8000) /* be more precise */
-                {
-                    /* ln(x ^ .5) = .5*ln(x) */
-                    d = fp16_log(d << 16) >> 1;
-                }
-                else
-                {
-                    d = fp_sqrt(d, 0); /* linear scaling, nothing
-                                          bad should happen */
-                    d = fp16_log(d << 16); /* the log function
-                                              expects s15.16 values */
-                }
+                /* ln(x ^ .5) = .5*ln(x), and taking d as s15.16 instead
+                 * of an integer only offsets the log by 16*ln(2) */
+                d = (fp16_log(d) + LN2_16) >> 1;
             }
             else
             {
@@ -745,7 +731,7 @@ static bool is_playing(void)
 static inline bool fft_init_fft_lib(void)
 {
     size_t size = sizeof(fft_buffer);
-    fft_state = kiss_fft_alloc(FFT_SIZE, 0, fft_buffer, &size);
+    fft_state = kiss_fftr_alloc(FFT_SIZE, 0, fft_buffer, &size);
 
     if(fft_state == NULL)
     {
@@ -758,39 +744,37 @@ static inline bool fft_init_fft_lib(void)
 
 static inline bool fft_get_fft(void)
 {
-    int count;
-    const int16_t *value =
-        rb->mixer_channel_get_buffer(PCM_MIXER_CHAN_PLAYBACK, &count);
-    /* This block can introduce discontinuities in our data. Meaning, the
-     * FFT will not be done a continuous segment of the signal. Which can
-     * be bad. Or not.
-     *
-     * Anyway, this is a demo, not a scientific tool. If you want accuracy,
-     * do a proper spectrum analysis.*/
-
-    /* there are cases when we don't have enough data to fill the buffer */
-    if(count != ARRAYLEN_IN)
+    static const int16_t * const coefs[] =
     {
-        if(count < ARRAYLEN_IN)
-            return false;
+        [FFT_WF_HAMMING] = HAMMING_COEFF,
+        [FFT_WF_HANN]    = HANN_COEFF,
+    };
 
-        count = ARRAYLEN_IN;  /* too much - limit */
-    }
+    const int16_t * const c = coefs[fft.window_func];
+    unsigned long pos = rb->mixer_get_output_tap_pos();
 
-    int fft_idx = 0; /* offset in 'input' */
+    /* Transform each time half a window of new output was mixed, so that
+     * successive windows overlap by half. */
+    if(pos < ARRAYLEN_IN || pos - input_tap_pos < ARRAYLEN_IN/2)
+        return false;
 
-    do
-    {
-        kiss_fft_scalar left = *value++;
-        kiss_fft_scalar right = *value++;
-        input[fft_idx].r = (left + right) >> 1; /* to mono */
-    } while (fft_idx++, --count > 0);
+    input_tap_pos = pos;
 
-    apply_window_func(fft.window_func);
+    const int16_t *value = pcm_tap;
+    unsigned idx = (pos - ARRAYLEN_IN) % ARRAYLEN_TAP;
+
+    /* Downmix to mono and apply the window in one pass */
+    for(int i = 0; i < ARRAYLEN_IN; ++i)
+    {
+        kiss_fft_scalar left = value[idx*2];
+        kiss_fft_scalar right = value[idx*2 + 1];
+        input[i] = (((left + right) >> 1) * c[i] + 16384) >> 15;
+        idx = (idx + 1) % ARRAYLEN_TAP;
+    }
 
     rb->yield();
 
-    kiss_fft(fft_state, input, output[output_tail]);
+    kiss_fftr(fft_state, input, output[output_tail]);
 
     rb->yield();
 
@@ -1188,6 +1172,8 @@ static void fft_osd_init(void *buf, size_t bufsize)
 
 static void fft_cleanup(void)
 {
+    rb->mixer_set_output_tap(NULL, 0);
+
     myosd_destroy();
 
     fft_close_fft();
@@ -1218,6 +1204,8 @@ static bool fft_setup(void)
                     CFGFILE_MINVERSION);
     fft = fft_disk; /* copy to running config */
 
+    rb->mixer_set_output_tap(pcm_tap, sizeof(pcm_tap));
+
     if(!fft_init_fft())
         return false;
 
@@ -150,7 +150,10 @@ static void get_pic_list(bool single_file)
     }
 
     struct tree_context *tree = rb->tree_get_context();
-    struct entry *dircache = rb->tree_get_entries(tree);
+    /* a folder too big for the tree's cache is loaded page by page, so
+       the names have to be copied to the end of the buffer */
+    bool paged = tree->dirlength > tree->filesindir;
+    struct entry *entry;
     int i;
     char *pname;
 
@@ -158,12 +161,25 @@ static void get_pic_list(bool single_file)
     pname = rb->strrchr(np_file,'/');
     pname++;
 
-    for (i = 0; i < tree->filesindir && buf_size > sizeof(char**); i++)
+    for (i = 0; i < tree->dirlength && buf_size > sizeof(char**); i++)
     {
+        entry = rb->tree_get_entry_at(tree, i);
+        if (!entry)
+            break;
+
         /* Add all files. Non-image files will be filtered out while loading. */
-        if (!(dircache[i].attr & ATTR_DIRECTORY))
+        if (!(entry->attr & ATTR_DIRECTORY))
         {
-            file_pt[entries] = dircache[i].name;
+            char *name = entry->name;
+            if (paged)
+            {
+                size_t len = rb->strlen(name) + 1;
+                if (buf_size < sizeof(char**) + len)
+                    break;
+                buf_size -= len;
+                name = rb->strcpy((char *)buf + buf_size, name);
+            }
+            file_pt[entries] = name;
             /* Set Selected File. */
             if (!rb->strcmp(file_pt[entries], pname))
                 curfile = entries;
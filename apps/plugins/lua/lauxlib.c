@@ -763,27 +763,105 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s) {
 /* }====================================================== */
 
 
+/*
+** Small objects (strings, tables, closures, upvalues) are recycled through
+** per size class free lists instead of going back to tlsf every time.
+** Lua always passes the old size of a block, so no header is needed: small
+** blocks are allocated rounded up to their class and any free block of a
+** class can satisfy any request in it.
+*/
+#define POOL_GRAIN    8
+#define POOL_CLASSES  16
+#define POOL_MAX      (POOL_GRAIN * POOL_CLASSES)
+
+#define pool_class(size) (((size) - 1) / POOL_GRAIN)
+
+static void *pool_list[POOL_CLASSES];
+
+static void *pool_alloc (size_t size) {
+  int c;
+  void *p;
+  if (size == 0)  /* pool_class(0) would underflow */
+    size = 1;
+  c = pool_class(size);
+  p = pool_list[c];
+  if (p != NULL) {
+    pool_list[c] = *(void **)p;
+    return p;
+  }
+  return malloc((c + 1) * POOL_GRAIN);
+}
+
+static void pool_release (void *p, size_t size) {
+  int c;
+  /* a block of unknown size can't be classed, let tlsf have it back */
+  if (size == 0 || size > POOL_MAX) {
+    free(p);
+    return;
+  }
+  c = pool_class(size);
+  *(void **)p = pool_list[c];
+  pool_list[c] = p;
+}
+
+/* hand all cached blocks back to tlsf so they can be merged */
+static void pool_flush (void) {
+  int c;
+  for (c = 0; c < POOL_CLASSES; c++) {
+    void *p = pool_list[c];
+    while (p != NULL) {
+      void *next = *(void **)p;
+      free(p);
+      p = next;
+    }
+    pool_list[c] = NULL;
+  }
+}
+
+static void *pool_realloc (void *ptr, size_t osize, size_t nsize) {
+  void *nptr;
+
+  if (ptr == NULL)
+    osize = 0;
+  else if (osize > POOL_MAX && nsize > POOL_MAX)
+    return realloc(ptr, nsize);
+  else if (osize > 0 && osize <= POOL_MAX &&
+           nsize > 0 && nsize <= POOL_MAX &&
+           pool_class(osize) == pool_class(nsize))
+    return ptr;
+
+  nptr = (nsize <= POOL_MAX) ? pool_alloc(nsize) : malloc(nsize);
+  if (nptr != NULL && ptr != NULL) {
+    memcpy(nptr, ptr, osize < nsize ? osize : nsize);
+    pool_release(ptr, osize);
+  }
+  return nptr;
+}
+
+
 static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
-  (void) osize;
   lua_State *L = (lua_State *)ud;
   void *nptr;
 
   if (nsize == 0) {
-    free(ptr);
+    if (ptr != NULL)
+      pool_release(ptr, osize);
     return NULL;
   }
 
-  nptr = realloc(ptr, nsize);
+  nptr = pool_realloc(ptr, osize, nsize);
   if (nptr == NULL) {
+    pool_flush();
     if(L != NULL)
     {
       luaC_fullgc(L); /* emergency full collection. */
-      nptr = realloc(ptr, nsize); /* try allocation again */
+      pool_flush();
     }
+    nptr = pool_realloc(ptr, osize, nsize); /* try allocation again */
 
     if (nptr == NULL) {
       LUA_OOM(L); /* if defined.. signal OOM condition */
-      nptr = realloc(ptr, nsize); /* try allocation again */
+      nptr = pool_realloc(ptr, osize, nsize); /* try allocation again */
     }
   }
 
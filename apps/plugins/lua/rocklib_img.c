@@ -1281,6 +1281,111 @@ RLI_LUA rli_clear(lua_State *L)
 
     return rli_marshal(L); /* (img*, [x1, y1, x2, y2, dx, dy, clip, function]) */
 }
+
+/* true if x, y is inside the image and has the color target as seen from
+ * lua. on >= 24 bit targets every int is a valid color, so there is no
+ * value left over to mark pixels outside the image */
+static inline bool rli_pixel_is(struct rocklua_image *img,
+                                int x, int y, int target)
+{
+    fb_data *element;
+
+    if(x < 1 || y < 1 || x > img->width || y > img->height)
+        return false;
+
+    element = rli_get_element(img, x, y);
+    if(!element)
+        return false;
+
+    return FB_UNPACK_SCALAR_LCD(data_get(element, x, y)) == target;
+}
+
+static inline void rli_pixel_fill(struct rocklua_image *img,
+                                  int x, int y, fb_data clr)
+{
+    data_set(rli_get_element(img, x, y), x, y, &clr);
+}
+
+RLI_LUA rli_floodfill(lua_State *L)
+{
+    /* (dst*, x, y, targetclr, fillclr) */
+    /* scanline 4-way flood, seeds for the rows above and below each filled
+       span are kept on a stack that grows in a lua userdata as needed */
+    struct rocklua_image *img = rli_checktype(L, 1);
+    int x = luaL_checkint(L, 2);
+    int y = luaL_checkint(L, 3);
+    int target = luaL_checkint(L, 4);
+    int fill = luaL_checkint(L, 5);
+    fb_data fillclr = lua_to_fbscalar(L, 5);
+
+    struct seed { short x, y; } *stack;
+    int size = 256;
+    int top = 0;
+
+    if(target == fill || !rli_pixel_is(img, x, y, target))
+        return 0;
+
+    lua_settop(L, 5);
+    stack = (struct seed *) lua_newuserdata(L, size * sizeof(struct seed));
+    stack[top].x = x;
+    stack[top++].y = y;
+
+    while(top > 0)
+    {
+        int lx, rx, ny, i;
+
+        top--;
+        x = stack[top].x;
+        y = stack[top].y;
+
+        if(!rli_pixel_is(img, x, y, target))
+            continue; /* already filled from another seed */
+
+        lx = rx = x;
+        while(rli_pixel_is(img, lx - 1, y, target))
+            lx--;
+        while(rli_pixel_is(img, rx + 1, y, target))
+            rx++;
+
+        for(i = lx; i <= rx; i++)
+            rli_pixel_fill(img, i, y, fillclr);
+
+        for(ny = y - 1; ny <= y + 1; ny += 2)
+        {
+            bool in_span = false;
+
+            for(i = lx; i <= rx; i++)
+            {
+                if(!rli_pixel_is(img, i, ny, target))
+                {
+                    in_span = false;
+                    continue;
+                }
+
+                if(in_span)
+                    continue;
+
+                in_span = true;
+
+                if(top >= size)
+                {
+                    /* the old stack is left for the garbage collector */
+                    struct seed *grown = (struct seed *)
+                        lua_newuserdata(L, 2 * size * sizeof(struct seed));
+                    rb->memcpy(grown, stack, size * sizeof(struct seed));
+                    lua_replace(L, 6);
+                    stack = grown;
+                    size *= 2;
+                }
+
+                stack[top].x = i;
+                stack[top++].y = ny;
+            }
+        }
+    }
+
+    return 0;
+}
 #endif /* RLI_EXTENDED */
 
 /* Rli Image methods exported to lua */
@@ -1303,6 +1408,7 @@ static const struct luaL_reg rli_lib [] =
     {"points",     rli_iterator_factory},
     {"line",       rli_line},
     {"ellipse",    rli_ellipse},
+    {"floodfill",  rli_floodfill},
 #endif /* RLI_EXTENDED */
 
     {NULL, NULL}
@@ -0,0 +1,71 @@
+--[[
+             __________               __   ___.
+   Open      \______   \ ____   ____ |  | _\_ |__   _______  ___
+   Source     |       _//  _ \_/ ___\|  |/ /| __ \ /  _ \  \/  /
+   Jukebox    |    |   (  <_> )  \___|    < | \_\ (  <_> > <  <
+   Firmware   |____|_  /\____/ \___  >__|_ \|___  /\____/__/\_ \
+                     \/            \/     \/    \/            \/
+ $Id$
+ Lua allocation rate and garbage collector pause benchmark
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+ This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF ANY
+ KIND, either express or implied.
+]]--
+
+-- Each run churns short lived strings, tables and closures for a few
+-- seconds while keeping a ring of them alive, the way a drawing loop does.
+-- It reports objects allocated per second and the longest gap between two
+-- iterations, which is where the collector paused the script.
+
+local DURATION = 3 * rb.HZ
+local KEEP = 256
+
+local function churn(i)
+    local t = {i, i + 1, name = "obj" .. i}
+    local f = function() return t end
+    return f
+end
+
+local function run(pause, stepmul)
+    local keep = {}
+    local objects = 0
+    local maxgap = 0
+
+    collectgarbage("collect")
+    local oldpause = collectgarbage("setpause", pause)
+    local oldstepmul = collectgarbage("setstepmul", stepmul)
+
+    local start = rb.current_tick()
+    local last = start
+    local now = start
+
+    while now - start < DURATION do
+        for i = 1, 64 do
+            keep[(objects + i) % KEEP + 1] = churn(objects + i)
+        end
+        objects = objects + 64 * 3 -- string, table and closure each
+
+        now = rb.current_tick()
+        if now - last > maxgap then maxgap = now - last end
+        last = now
+    end
+
+    collectgarbage("setpause", oldpause)
+    collectgarbage("setstepmul", oldstepmul)
+
+    local rate = objects * rb.HZ / (now - start)
+    return string.format("pause %d stepmul %d:\n %d obj/s, max gap %d ms\n",
+                         pause, stepmul, rate, maxgap * 1000 / rb.HZ)
+end
+
+local s_t = {}
+s_t[#s_t + 1] = "gcbench\n"
+rb.splash(0, "Running...")
+s_t[#s_t + 1] = run(125, 200) -- rockbox defaults
+s_t[#s_t + 1] = run(150, 400) -- collect earlier, in larger steps
+s_t[#s_t + 1] = run(300, 100) -- let the heap grow, smaller steps
+s_t[#s_t + 1] = string.format("lua used: %d Kb\n", collectgarbage("count"))
+rb.splash_scroller(10 * rb.HZ, table.concat(s_t))
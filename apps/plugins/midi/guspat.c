@@ -47,14 +47,20 @@ const uint32_t freqtable[]=
   4186009, 4434922, 4698636, 4978032, 5274041,  5587652,  5919911,  6271927, 6644875, 7040000, 7458620, 7902133,
   8372018, 8869844, 9397273, 9956063, 10548082, 11175303, 11839822, 12543854 };
 
-static unsigned int readWord(int file)
+/* Sizes of the fixed headers in a GUS patch file. Each one is read with a
+ * single call and the fields are picked out of the buffer, which is a lot
+ * faster than reading them byte by byte from disk. */
+#define GUS_PATCH_HDR_SIZE    239   /* patch, instrument and layer headers */
+#define GUS_WAVE_HDR_SIZE     96
+
+static inline unsigned int getWord(const unsigned char *p)
 {
-    return (readChar(file)<<0) | (readChar(file)<<8); // | (readChar(file)<<8) | (readChar(file)<<0);
+    return p[0] | (p[1] << 8);
 }
 
-static unsigned int readDWord(int file)
+static inline unsigned int getDWord(const unsigned char *p)
 {
-    return (readChar(file)<<0) | (readChar(file)<<8) | (readChar(file)<<16) | (readChar(file)<<24);
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
 }
 
 int curr_waveform;
@@ -62,47 +68,49 @@ struct GWaveform waveforms[256] IBSS_ATTR;
 
 static struct GWaveform * loadWaveform(int file)
 {
-    struct GWaveform * wav = &waveforms[curr_waveform++];
-    rb->memset(wav, 0, sizeof(struct GWaveform));
-
-    wav->name=readData(file, 7);
-    if (!wav->name)
+    if (curr_waveform >= (int)ARRAYLEN(waveforms))
+    {
+        midi_debug("Too many waveforms");
         return NULL;
-/*    printf("\nWAVE NAME = [%s]", wav->name); */
-    wav->fractions=readChar(file);
-    wav->wavSize=readDWord(file);
-    wav->startLoop=readDWord(file);
-    wav->endLoop=readDWord(file);
-    wav->sampRate=readWord(file);
-
-    wav->lowFreq=readDWord(file);
-    wav->highFreq=readDWord(file);
-    wav->rootFreq=readDWord(file);
+    }
 
-    wav->tune=readWord(file);
+    struct GWaveform * wav = &waveforms[curr_waveform++];
+    rb->memset(wav, 0, sizeof(struct GWaveform));
 
-    wav->balance=readChar(file);
-    wav->envRate=readData(file, 6);
-    if (!wav->envRate)
+    unsigned char *hdr = readData(file, GUS_WAVE_HDR_SIZE);
+    if (!hdr)
         return NULL;
-    wav->envOffset=readData(file, 6);
-    if (!wav->envOffset)
-        return NULL;
-
-    wav->tremSweep=readChar(file);
-    wav->tremRate=readChar(file);
-    wav->tremDepth=readChar(file);
-    wav->vibSweep=readChar(file);
-    wav->vibRate=readChar(file);
-    wav->vibDepth=readChar(file);
-    wav->mode=readChar(file);
 
-    wav->scaleFreq=readWord(file);
-    wav->scaleFactor=readWord(file);
+    wav->name=hdr;
+/*    printf("\nWAVE NAME = [%s]", wav->name); */
+    wav->fractions=hdr[7];
+    wav->wavSize=getDWord(hdr+8);
+    wav->startLoop=getDWord(hdr+12);
+    wav->endLoop=getDWord(hdr+16);
+    wav->sampRate=getWord(hdr+20);
+
+    wav->lowFreq=getDWord(hdr+22);
+    wav->highFreq=getDWord(hdr+26);
+    wav->rootFreq=getDWord(hdr+30);
+
+    wav->tune=getWord(hdr+34);
+
+    wav->balance=hdr[36];
+    wav->envRate=hdr+37;
+    wav->envOffset=hdr+43;
+
+    wav->tremSweep=hdr[49];
+    wav->tremRate=hdr[50];
+    wav->tremDepth=hdr[51];
+    wav->vibSweep=hdr[52];
+    wav->vibRate=hdr[53];
+    wav->vibDepth=hdr[54];
+    wav->mode=hdr[55];
+
+    wav->scaleFreq=getWord(hdr+56);
+    wav->scaleFactor=getWord(hdr+58);
 /*    printf("\nScaleFreq = %d   ScaleFactor = %d   RootFreq = %d", wav->scaleFreq, wav->scaleFactor, wav->rootFreq); */
-    wav->res=readData(file, 36);
-    if (!wav->res)
-        return NULL;
+    wav->res=hdr+60;
     wav->data=readData(file, wav->wavSize);
     if (!wav->data)
         return NULL;
@@ -173,8 +181,25 @@ static int selectWaveform(struct GPatch * pat, int midiNote)
     return 0;
 }
 
+/* Patches that have already been loaded, so instruments and drums that
+ * share a .pat file in the patchset config are only read and converted once */
+static struct
+{
+    char *name;
+    struct GPatch *gp;
+} loaded[256];
+static int num_loaded;
+
 struct GPatch * gusload(char * filename)
 {
+    int a;
+
+    for (a = 0; a < num_loaded; a++)
+    {
+        if (!rb->strcmp(loaded[a].name, filename))
+            return loaded[a].gp;
+    }
+
     struct GPatch * gp = (struct GPatch *)malloc(sizeof(struct GPatch));
 
     if (gp)
@@ -191,68 +216,39 @@ struct GPatch * gusload(char * filename)
         return NULL;
     }
 
-    gp->header=readData(file, 12);
-    if (!gp->header)
-    {
-        rb->close(file);
-        return NULL;
-    }
-    gp->gravisid=readData(file, 10);
-    if (!gp->gravisid)
-    {
-        rb->close(file);
-        return NULL;
-    }
-    gp->desc=readData(file, 60);
-    if (!gp->desc)
-    {
-        rb->close(file);
-        return NULL;
-    }
-    gp->inst=readChar(file);
-    gp->voc=readChar(file);
-    gp->chan=readChar(file);
-    gp->numWaveforms=readWord(file);
-    gp->vol=readWord(file);
-    gp->datSize=readDWord(file);
-    gp->res=readData(file, 36);
-    if (!gp->res)
-    {
-        rb->close(file);
-        return NULL;
-    }
-
-    gp->instrID=readWord(file);
-    gp->instrName=readData(file,16);
-    if (!gp->instrName)
-    {
-        rb->close(file);
-        return NULL;
-    }
-    gp->instrSize=readDWord(file);
-    gp->layers=readChar(file);
-    gp->instrRes=readData(file,40);
-    if (!gp->instrRes)
+    unsigned char *hdr = readData(file, GUS_PATCH_HDR_SIZE);
+    if (!hdr)
     {
         rb->close(file);
         return NULL;
     }
 
-    gp->layerDup=readChar(file);
-    gp->layerID=readChar(file);
-    gp->layerSize=readDWord(file);
-    gp->numWaves=readChar(file);
-    gp->layerRes=readData(file,40);
-    if (!gp->layerRes)
-    {
-        rb->close(file);
-        return NULL;
-    }
+    gp->header=hdr;
+    gp->gravisid=hdr+12;
+    gp->desc=hdr+22;
+    gp->inst=hdr[82];
+    gp->voc=hdr[83];
+    gp->chan=hdr[84];
+    gp->numWaveforms=getWord(hdr+85);
+    gp->vol=getWord(hdr+87);
+    gp->datSize=getDWord(hdr+89);
+    gp->res=hdr+93;
+
+    gp->instrID=getWord(hdr+129);
+    gp->instrName=hdr+131;
+    gp->instrSize=getDWord(hdr+147);
+    gp->layers=hdr[151];
+    gp->instrRes=hdr+152;
+
+    gp->layerDup=hdr[192];
+    gp->layerID=hdr[193];
+    gp->layerSize=getDWord(hdr+194);
+    gp->numWaves=hdr[198];
+    gp->layerRes=hdr+199;
 
 /*    printf("\nFILE: %s", filename); */
 /*    printf("\nlayerSamples=%d", gp->numWaves); */
 
-    int a=0;
     for(a=0; a<gp->numWaves; a++)
     {
         gp->waveforms[a] = loadWaveform(file);
@@ -271,6 +267,16 @@ struct GPatch * gusload(char * filename)
     }
     rb->close(file);
 
+    if (num_loaded < (int)ARRAYLEN(loaded))
+    {
+        loaded[num_loaded].name = malloc(rb->strlen(filename) + 1);
+        if (loaded[num_loaded].name)
+        {
+            rb->strcpy(loaded[num_loaded].name, filename);
+            loaded[num_loaded++].gp = gp;
+        }
+    }
+
     return gp;
 }
 
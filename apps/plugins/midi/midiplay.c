@@ -490,9 +490,25 @@ static void get_more(const void** start, size_t* size)
     *size = samples_in_buf*sizeof(int32_t);
 }
 
+/* Show the voice counts on the bottom line, which midi_debug() leaves free */
+static void show_voices(void)
+{
+    char buf[32];
+    int y = LCD_HEIGHT - 8;
+
+    rb->snprintf(buf, sizeof(buf), "Peak %d/%d stolen %d",
+                 peak_voices, MAX_VOICES, stolen_voices);
+    rb->lcd_set_drawmode(DRMODE_SOLID|DRMODE_INVERSEVID);
+    rb->lcd_fillrect(0, y, LCD_WIDTH, 8);
+    rb->lcd_set_drawmode(DRMODE_SOLID);
+    rb->lcd_putsxy(1, y, (unsigned char *)buf);
+    rb->lcd_update_rect(0, y, LCD_WIDTH, 8);
+}
+
 static int midimain(const void * filename)
 {
     int a, notes_used, vol;
+    int shown_peak = -1, shown_stolen = -1, shown_time = -1;
     bool is_playing = true;  /* false = paused */
 
 #if defined(HAVE_ADJUSTABLE_CPU_FREQ)
@@ -571,6 +587,8 @@ static int midimain(const void * filename)
 #endif
 
     playing_time = 0;
+    peak_voices = 0;
+    stolen_voices = 0;
     samples_this_second = 0;
 
 #ifndef SYNC
@@ -590,6 +608,16 @@ static int midimain(const void * filename)
         /* Prevent idle poweroff */
         rb->reset_poweroff_timer();
 
+        /* Also redraw every second, midi_debug() may have cleared the screen */
+        if (peak_voices != shown_peak || stolen_voices != shown_stolen ||
+            playing_time != shown_time)
+        {
+            shown_peak = peak_voices;
+            shown_stolen = stolen_voices;
+            shown_time = playing_time;
+            show_voices();
+        }
+
         /* Code taken from Oscilloscope plugin */
         switch (rb->button_get(false))
         {
@@ -156,8 +156,9 @@ int midi_debug(const char *fmt, ...)
     rb->lcd_putsxy(1,p_xtpt, (unsigned char *)p_buf);
     rb->lcd_update();
 
+    /* the bottom line is kept for the voice counts during playback */
     p_xtpt+=8;
-    if(p_xtpt>LCD_HEIGHT-8)
+    if(p_xtpt>LCD_HEIGHT-16)
     {
         p_xtpt=0;
         rb->lcd_clear_display();
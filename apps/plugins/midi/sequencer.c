@@ -25,6 +25,7 @@
 #include "sequencer.h"
 
 long tempo = 375000;
+int stolen_voices = 0; /* Notes that had to cut off a playing voice */
 
 /* From the old patch config.... each patch is scaled.
  * Should be moved into patchset.cfg
@@ -187,9 +188,40 @@ static inline void setPW(int ch, int msb, int lsb)
     computeDeltas(ch);
 }
 
+/* Picks the voice to cut when all voices are busy. Voices already ramping
+ * down go first, then released notes, then the quietest held note; among
+ * equals the one with the lowest envelope * volume product is chosen. */
+static int findVictim(void)
+{
+    int a, victim = 0;
+    int best = INT_MAX;
+
+    for (a = 0; a < MAX_VOICES; a++)
+    {
+        struct SynthObject *so = &voices[a];
+        int score;
+
+        if (so->state == STATE_RAMPDOWN)
+            return a;
+
+        score = (so->curOffset >> 22) * so->volscale;
+        if (score < 0)
+            score = -score;
+        if (so->curPoint < 3)
+            score += 1 << 25; /* still held, above any released note */
+
+        if (score < best)
+        {
+            best = score;
+            victim = a;
+        }
+    }
+
+    return victim;
+}
+
 static inline void pressNote(int ch, int note, int vol)
 {
-    static int lastKill = 0;
 /* Silences all channels but one, for easy debugging, for me. */
 /*
     if(ch == 0) return;
@@ -220,16 +252,9 @@ static inline void pressNote(int ch, int note, int vol)
     }
     if (a == MAX_VOICES)
     {
-//        midi_debug("\nVoice kill");
-//        midi_debug("\nToo many voices playing at once. No more left");
-//        midi_debug("\nVOICE DUMP: ");
-//        for(a=0; a<48; a++)
-//            midi_debug("\n#%d  Ch=%d  Note=%d  curRate=%d   curOffset=%d   curPoint=%d   targetOffset=%d", a, voices[a].ch, voices[a].note, voices[a].curRate, voices[a].curOffset, voices[a].curPoint, voices[a].targetOffset);
-        lastKill++;
-        if (lastKill == MAX_VOICES)
-            lastKill = 0;
-        a = lastKill;
-//        return; /* None available */
+        /* Too many voices playing at once, steal the least audible one */
+        a = findVictim();
+        stolen_voices++;
     }
     voices[a].ch = ch;
     voices[a].note = note;
@@ -28,4 +28,5 @@ void seekForward(int nSec);
 void seekBackward(int nSec);
 
 extern long tempo;
+extern int stolen_voices;
 
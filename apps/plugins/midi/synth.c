@@ -23,6 +23,8 @@
 #include "midiutil.h"
 #include "synth.h"
 
+int peak_voices = 0; /* Most voices rendered in a single block */
+
 static void readTextBlock(int file, char * buf)
 {
     char c = 0;
@@ -449,6 +451,7 @@ size_t synthSamples(int32_t *buf_ptr, size_t num_samples) ICODE_ATTR;
 size_t synthSamples(int32_t *buf_ptr, size_t num_samples)
 {
     unsigned int i;
+    int active = 0;
     struct SynthObject *voicept;
     size_t nsamples = MIN(num_samples, MAX_SAMPLES);
 
@@ -460,9 +463,13 @@ size_t synthSamples(int32_t *buf_ptr, size_t num_samples)
         if(voicept->isUsed)
         {
             synthVoice(voicept, buf_ptr, nsamples);
+            active++;
         }
     }
 
+    if (active > peak_voices)
+        peak_voices = active;
+
     /* TODO: Automatic Gain Control, anyone? */
     /* Or, should this be implemented on the DSP's output volume instead? */
 
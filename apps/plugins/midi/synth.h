@@ -22,6 +22,8 @@ int initSynth(struct MIDIfile * mf, char * filename, char * drumConfig);
 void setPoint(struct SynthObject * so, int pt);
 size_t synthSamples(int32_t *buf_ptr, size_t num_samples);
 
+extern int peak_voices;
+
 void resetControllers(void);
 
 static inline struct Event * getEvent(struct Track * tr, int evNum)
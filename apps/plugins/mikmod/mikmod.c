@@ -187,7 +187,10 @@ static bool mod_ext(const char ext[])
 static void get_mod_list(void)
 {
     struct tree_context *tree = rb->tree_get_context();
-    struct entry *dircache = rb->tree_get_entries(tree);
+    /* a folder too big for the tree's cache is loaded page by page, so
+       the names have to be copied to the end of the buffer */
+    bool paged = tree->dirlength > tree->filesindir;
+    struct entry *entry;
     int i;
     char *pname;
 
@@ -197,12 +200,26 @@ static void get_mod_list(void)
     pname = rb->strrchr(np_file,'/');
     pname++;
 
-    for (i = 0; i < tree->filesindir && audio_buffer_free > sizeof(char**); i++)
+    for (i = 0; i < tree->dirlength && audio_buffer_free > sizeof(char**); i++)
     {
-        if (!(dircache[i].attr & ATTR_DIRECTORY)
-            && mod_ext(rb->strrchr(dircache[i].name,'.')))
+        entry = rb->tree_get_entry_at(tree, i);
+        if (!entry)
+            break;
+
+        if (!(entry->attr & ATTR_DIRECTORY)
+            && mod_ext(rb->strrchr(entry->name,'.')))
         {
-            file_pt[entries] = dircache[i].name;
+            char *name = entry->name;
+            if (paged)
+            {
+                size_t len = rb->strlen(name) + 1;
+                if (audio_buffer_free < sizeof(char**) + len)
+                    break;
+                audio_buffer_free -= len;
+                name = rb->strcpy((char *)audio_buffer + audio_buffer_free,
+                                  name);
+            }
+            file_pt[entries] = name;
             /* Set Selected File. */
             if (!rb->strcmp(file_pt[entries], pname))
                 curfile = entries;
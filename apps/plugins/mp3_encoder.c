@@ -2701,17 +2701,22 @@ enum plugin_status plugin_start(const void* parameter)
             rb->sleep(5*HZ);
         }
 
+        /* realtime factor in 1/100 units: WAV length / conversion time */
+        long len = frames * cfg.smpl_per_frm * 100 / (cfg.samplerate != 0 ? cfg.samplerate : 1); /* unit=.01s */
+        long rtf = len * HZ / (tim != 0 ? tim : 1);
+
         rb->lcd_clear_display();
 #if LCD_WIDTH <= 128
         rb->lcd_putsxy(0, 30, "Conversion:");
-        rb->lcd_putsxyf(0, 40,"%ld.%02lds    ", tim/100, tim%100);
-        tim = frames * cfg.smpl_per_frm * 100 / (cfg.samplerate != 0 ? cfg.samplerate : 1); /* unit=.01s */
+        rb->lcd_putsxyf(0, 40,"%ld.%02lds    ", tim/HZ, tim%HZ * 100 / HZ);
         rb->lcd_putsxy(0, 10, "WAV-Length:");
-        rb->lcd_putsxyf(0, 20, "%ld.%02lds    ", tim/100, tim%100);
+        rb->lcd_putsxyf(0, 20, "%ld.%02lds    ", len/100, len%100);
+        rb->lcd_putsxy(0, 50, "Speed:");
+        rb->lcd_putsxyf(0, 60, "%ld.%02ldx realtime", rtf/100, rtf%100);
 #else
-        rb->lcd_putsxyf(0, 30, "  Conversion: %ld.%02lds    ", tim/100, tim%100);
-        tim = frames * cfg.smpl_per_frm * 100 / (cfg.samplerate != 0 ? cfg.samplerate : 1); /* unit=.01s */
-        rb->lcd_putsxyf(0, 20, "  WAV-Length: %ld.%02lds    ", tim/100, tim%100);
+        rb->lcd_putsxyf(0, 30, "  Conversion: %ld.%02lds    ", tim/HZ, tim%HZ * 100 / HZ);
+        rb->lcd_putsxyf(0, 20, "  WAV-Length: %ld.%02lds    ", len/100, len%100);
+        rb->lcd_putsxyf(0, 40, "  Speed: %ld.%02ldx realtime", rtf/100, rtf%100);
 #endif
         rb->lcd_update();
         rb->sleep(5*HZ);
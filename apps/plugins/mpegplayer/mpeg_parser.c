@@ -25,8 +25,70 @@
 
 struct stream_parser str_parser SHAREDBSS_ATTR;
 
+/* Positions of timestamped video packets seen while streaming, sorted by
+ * time. Seeks start bisecting between the two entries around the target
+ * instead of across the whole file. */
+#define SEEK_INDEX_SIZE 1024
+
+static struct seek_index
+{
+    int      count;
+    uint32_t interval;          /* Minimum time between entries */
+    struct
+    {
+        uint32_t pts;
+        off_t    pos;
+    } ent[SEEK_INDEX_SIZE];
+} seek_index SHAREDBSS_ATTR;
+
+/* Find the last entry at or before time, -1 if there is none */
+static int seek_index_find(uint32_t time)
+{
+    int lo = 0, hi = seek_index.count;
+
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+
+        if (seek_index.ent[mid].pts <= time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo - 1;
+}
+
+static void seek_index_add(uint32_t pts, off_t pos)
+{
+    int i = seek_index_find(pts);
+
+    /* Keep entries spread out and both keys in the same order - anything
+     * else is a timestamp discontinuity that would mislead a seek */
+    if (i >= 0 && (pts - seek_index.ent[i].pts < seek_index.interval ||
+                   pos <= seek_index.ent[i].pos))
+        return;
+
+    i++;
+
+    if (i < seek_index.count &&
+        (seek_index.ent[i].pts - pts < seek_index.interval ||
+         pos >= seek_index.ent[i].pos))
+        return;
+
+    if (seek_index.count >= SEEK_INDEX_SIZE)
+        return;
+
+    rb->memmove(&seek_index.ent[i + 1], &seek_index.ent[i],
+                (seek_index.count - i) * sizeof (seek_index.ent[0]));
+    seek_index.ent[i].pts = pts;
+    seek_index.ent[i].pos = pos;
+    seek_index.count++;
+}
+
 static void parser_init_state(void)
 {
+    seek_index.count = 0;
     str_parser.last_seek_time = 0;
     str_parser.format = STREAM_FMT_UNKNOWN;
     str_parser.start_pts = INVALID_TIMESTAMP;
@@ -364,9 +426,26 @@ static off_t mpeg_parser_seek_PTS(uint32_t time, unsigned id)
     uint32_t prevpts = 0;
     enum state_enum state = STATE0;
     struct stream_scan sk;
+    int i;
 
     stream_scan_init(&sk);
 
+    /* Narrow the window to what has already been seen around the target -
+     * the index only holds video packets */
+    i = STREAM_IS_VIDEO(id) ? seek_index_find(time) : -1;
+
+    if (i >= 0)
+    {
+        pos_left = seek_index.ent[i].pos;
+        time_left = seek_index.ent[i].pts;
+    }
+
+    if (i + 1 < seek_index.count && STREAM_IS_VIDEO(id))
+    {
+        pos_right = seek_index.ent[i + 1].pos;
+        time_right = seek_index.ent[i + 1].pts;
+    }
+
     /* Initial estimate taken from average bitrate - later interpolations are
      * taken similarly based on the remaining file interval */
     pos_new = muldiv_uint32(time - time_left, pos_right - pos_left,
@@ -375,6 +454,13 @@ static off_t mpeg_parser_seek_PTS(uint32_t time, unsigned id)
     /* return this estimated position if nothing better comes up */
     pos = pos_new;
 
+    if (i >= 0)
+    {
+        /* A known packet before the target is better than any guess */
+        pts = time_left;
+        pos = pos_left;
+    }
+
     DEBUGF("Seeking stream 0x%02x\n", id);
     DEBUGF("$$ tl:%u t:%u ct:?? tr:%u\n   pl:%ld pn:%ld pr:%ld\n",
            (unsigned)time_left, (unsigned)time, (unsigned)time_right,
@@ -868,6 +954,13 @@ static int parse_demux(struct stream *str, enum stream_parse_mode type)
             }
         }
 
+        if (type == STREAM_PM_STREAMING && STREAM_IS_VIDEO(id) &&
+            (str->pkt_flags & PKT_HAS_TS))
+        {
+            /* win_right is still the file position of the header */
+            seek_index_add(str->pts, str->hdr.win_right);
+        }
+
         p += length;
         /* Max bytes: 6 + 65535 - 7 = 65534 */
         bytes = 6 + (header[4] << 8) + header[5] - length;
@@ -1178,6 +1271,10 @@ int parser_init_stream(void)
     /* Cache duration - it's used very often */
     str_parser.duration = str_parser.end_pts - str_parser.start_pts;
 
+    /* Space index entries so the whole movie fits */
+    seek_index.interval = MAX(str_parser.duration / SEEK_INDEX_SIZE,
+                              TS_SECOND);
+
     DEBUGF("Movie info:\n"
            "  size:%dx%d\n"
            "  start:%u\n"
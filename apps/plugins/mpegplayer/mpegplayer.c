@@ -633,9 +633,9 @@ struct fps
     int pf_width;
     int pf_height;
     long update_tick;       /* When to next update FPS reading */
-    #define FPS_FORMAT  "%d.%02d"
-    #define FPS_DIMSTR  "999.99" /* For establishing rect size */
-    #define FPS_BUFSIZE sizeof("999.99")
+    #define FPS_FORMAT  "%d.%02d %d/%dms"
+    #define FPS_DIMSTR  "999.99 999/999ms" /* For establishing rect size */
+    #define FPS_BUFSIZE sizeof(FPS_DIMSTR)
 };
 
 static struct osd osd;
@@ -1194,7 +1194,8 @@ static void fps_refresh(void)
     stream_video_stats(&stats);
 
     rb->snprintf(str, FPS_BUFSIZE, FPS_FORMAT,
-                 stats.fps / 100, stats.fps % 100);
+                 stats.fps / 100, stats.fps % 100,
+                 stats.decode_ms, stats.draw_ms);
 
     w = fps.rect.r - fps.rect.l;
     h = fps.rect.b - fps.rect.t;
@@ -2117,29 +2118,35 @@ static bool is_videofile(const char* file)
 static bool get_videofile(int direction, char* videofile, size_t bufsize)
 {
     struct tree_context *tree = rb->tree_get_context();
-    struct entry *dircache = rb->tree_get_entries(tree);
+    struct entry *entry;
     int i, step, end, found = 0;
     char *videoname = rb->strrchr(videofile, '/') + 1;
     size_t rest = bufsize - (videoname - videofile) - 1;
 
+    /* tree_get_entry_at() loads the pages of a folder too big for the
+       cache as they are needed */
     if (direction == VIDEO_NEXT) {
         i = 0;
         step = 1;
-        end = tree->filesindir;
+        end = tree->dirlength;
     } else {
-        i = tree->filesindir-1;
+        i = tree->dirlength-1;
         step = -1;
         end = -1;
     }
     for (; i != end; i += step)
     {
-        const char* name = dircache[i].name;
+        entry = rb->tree_get_entry_at(tree, i);
+        if (!entry)
+            break;
+
+        const char* name = entry->name;
         if (!rb->strcmp(name, videoname)) {
             found = 1;
             continue;
         }
         if (found && rb->strlen(name) <= rest &&
-            !(dircache[i].attr & ATTR_DIRECTORY) && is_videofile(name))
+            !(entry->attr & ATTR_DIRECTORY) && is_videofile(name))
         {
             rb->strcpy(videoname, name);
             return true;
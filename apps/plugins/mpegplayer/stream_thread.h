@@ -167,6 +167,8 @@ struct video_output_stats
     int    num_drawn;       /* Number of frames drawn since reset */
     int    num_skipped;     /* Number of frames skipped since reset */
     int    fps;             /* fps rate in 100ths of a frame per second */
+    int    decode_ms;       /* Average decode time per frame drawn */
+    int    draw_ms;         /* Average convert and draw time per frame */
 };
 
 void video_thread_get_stats(struct video_output_stats *s);
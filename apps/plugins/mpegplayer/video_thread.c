@@ -59,6 +59,9 @@ struct video_thread_data
 static int video_num_drawn SHAREDBSS_ATTR;
 /* Number skipped since reset */
 static int video_num_skipped SHAREDBSS_ATTR;
+/* Ticks spent in the decoder and in drawing since reset */
+static long video_decode_ticks SHAREDBSS_ATTR;
+static long video_draw_ticks SHAREDBSS_ATTR;
 
 /* TODO: Check if 4KB is appropriate - it works for my test streams,
    so maybe we can reduce it. */
@@ -577,6 +580,8 @@ static void video_thread_msg(struct video_thread_data *td)
             td->last_render = *rb->current_tick - HZ;
             video_num_drawn = 0;
             video_num_skipped = 0;
+            video_decode_ticks = 0;
+            video_draw_ticks = 0;
 
             reply = true;
             break;
@@ -694,6 +699,7 @@ static void video_thread(void)
     while (1)
     {
         mpeg2_state_t mp2state;
+        long tick;
         td.state = TSTATE_DECODE;
 
         /* Check for any pending messages and process them */
@@ -719,7 +725,9 @@ static void video_thread(void)
         }
 
     picture_decode:
+        tick = *rb->current_tick;
         mp2state = mpeg2_parse (td.mpeg2dec);
+        video_decode_ticks += *rb->current_tick - tick;
 
         switch (mp2state)
         {
@@ -975,6 +983,7 @@ static void video_thread(void)
             td.last_render = *rb->current_tick;
 
             vo_draw_frame(td.info->display_fbuf->buf);
+            video_draw_ticks += *rb->current_tick - td.last_render;
             video_num_drawn++;
             break;
 
@@ -1052,8 +1061,16 @@ void video_thread_get_stats(struct video_output_stats *s)
     s->num_skipped = video_num_skipped;
 
     s->fps = 0;
+    s->decode_ms = 0;
+    s->draw_ms = 0;
 
     if (now > start)
         s->fps = muldiv_uint32(CLOCK_RATE*100, s->num_drawn, now - start);
+
+    if (s->num_drawn > 0)
+    {
+        s->decode_ms = video_decode_ticks * (1000 / HZ) / s->num_drawn;
+        s->draw_ms = video_draw_ticks * (1000 / HZ) / s->num_drawn;
+    }
 }
 
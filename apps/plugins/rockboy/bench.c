@@ -0,0 +1,149 @@
+#include "rockmacros.h"
+#include "defs.h"
+#include "regs.h"
+#include "hw.h"
+#include "cpu-gb.h"
+#include "mem.h"
+
+/*
+ * cpu_bench runs a fixed instruction stream, built in so no ROM is
+ * needed, first through the interpreter and then for the same number
+ * of cycles through the threaded-code translator. It shows the speed
+ * of both and checks that they leave the cpu and memory in the same
+ * state.
+ */
+
+/* one frame of emulated time, as emu_run() steps it */
+#define BENCH_FRAME 35112
+/* how long the interpreter runs, which sets the frame count */
+#define BENCH_TIME (HZ*2)
+
+/* Fills C000-CFFF, then loops forever summing it into DE through a
+ * subroutine and rotating its first 64 bytes in place: loads, stores,
+ * ALU, CB ops, calls and taken and untaken branches */
+static byte bench_rom[1][16384] =
+{{
+    [0x0100] =
+    0x31, 0xFE, 0xDF,       /* LD SP,DFFE */
+    0x21, 0x00, 0xC0,       /* LD HL,C000 */
+    0x01, 0x00, 0x10,       /* LD BC,1000 */
+    0x79,                   /* 0109: LD A,C */
+    0xA8,                   /* XOR B */
+    0x22,                   /* LDI (HL),A */
+    0x0B,                   /* DEC BC */
+    0x78,                   /* LD A,B */
+    0xB1,                   /* OR C */
+    0x20, 0xF8,             /* JR NZ,0109 */
+    0x21, 0x00, 0xC0,       /* 0111: LD HL,C000 */
+    0x11, 0x00, 0x00,       /* LD DE,0000 */
+    0x06, 0x00,             /* LD B,00 */
+    0x2A,                   /* 0119: LDI A,(HL) */
+    0xCD, 0x40, 0x01,       /* CALL 0140 */
+    0x05,                   /* DEC B */
+    0x20, 0xF9,             /* JR NZ,0119 */
+    0x7B,                   /* LD A,E */
+    0x21, 0x00, 0xD0,       /* LD HL,D000 */
+    0x77,                   /* LD (HL),A */
+    0x21, 0x00, 0xC0,       /* LD HL,C000 */
+    0x0E, 0x40,             /* LD C,40 */
+    0xCB, 0x06,             /* 012A: RLC (HL) */
+    0x23,                   /* INC HL */
+    0x0D,                   /* DEC C */
+    0x20, 0xFA,             /* JR NZ,012A */
+    0xC3, 0x11, 0x01,       /* JP 0111 */
+
+    [0x0140] =
+    0xF5,                   /* PUSH AF */
+    0x83,                   /* ADD A,E */
+    0x5F,                   /* LD E,A */
+    0x7A,                   /* LD A,D */
+    0xCE, 0x00,             /* ADC A,00 */
+    0x57,                   /* LD D,A */
+    0xF1,                   /* POP AF */
+    0xCB, 0x37,             /* SWAP A */
+    0xE6, 0x0F,             /* AND 0F */
+    0xFE, 0x08,             /* CP 08 */
+    0x38, 0x03,             /* JR C,0153 */
+    0xCB, 0x3A,             /* SRL D */
+    0x00,                   /* NOP */
+    0xC9,                   /* 0153: RET */
+}};
+
+static struct cpu bench_cpu;
+static byte bench_ram[2][4096];
+static byte bench_hi[256];
+
+static void bench_reset(void)
+{
+    memset(ram.ibank, 0, sizeof(ram.ibank));
+    memset(ram.hi, 0, sizeof(ram.hi));
+    memset(&hw, 0, sizeof(hw));
+    /* a single bank, nothing mapped at 4000-7FFF */
+    memset(&mbc, 0, sizeof(mbc));
+    mbc.romsize = 1;
+    mbc.rombank = 1;
+    rom.bank = bench_rom;
+    mem_updatemap();
+    options.sound = 0;
+    cpu_reset();
+}
+
+/* runs *frames frames, or as many as fit in BENCH_TIME if it is 0,
+ * and returns the ticks taken */
+static long bench_run(bool translate, int *frames)
+{
+    long start;
+    int n;
+
+    bench_reset();
+    cpu_translate = translate;
+    start = *rb->current_tick;
+    for (n = 0; *frames ? n < *frames
+                        : *rb->current_tick - start < BENCH_TIME; n++)
+    {
+        cpu_emulate(BENCH_FRAME);
+        if (!(n & 63))
+            rb->yield();
+    }
+    *frames = n;
+    return *rb->current_tick - start;
+}
+
+void cpu_bench(void)
+{
+    int frames = 0;
+    long interp, trans;
+    int interp_fps, trans_fps, speedup;
+    bool match;
+
+    rb->lcd_clear_display();
+    rb->lcd_puts(0, 0, "Running...");
+    rb->lcd_update();
+
+    interp = bench_run(false, &frames);
+    memcpy(&bench_cpu, &cpu, sizeof(cpu));
+    memcpy(bench_ram, ram.ibank, sizeof(bench_ram));
+    memcpy(bench_hi, ram.hi, sizeof(bench_hi));
+
+    trans = bench_run(true, &frames);
+    match = !rb->memcmp(&bench_cpu, &cpu, sizeof(cpu))
+            && !rb->memcmp(bench_ram, ram.ibank, sizeof(bench_ram))
+            && !rb->memcmp(bench_hi, ram.hi, sizeof(bench_hi));
+    cpu_translate = true;
+
+    interp_fps = frames * HZ / MAX(interp, 1);
+    trans_fps = frames * HZ / MAX(trans, 1);
+    speedup = interp * 100 / MAX(trans, 1);
+
+    rb->lcd_clear_display();
+    rb->lcd_putsf(0, 0, "%d frames", frames);
+    rb->lcd_putsf(0, 1, "Interpreted: %d fps", interp_fps);
+    rb->lcd_putsf(0, 2, "Translated: %d fps", trans_fps);
+    rb->lcd_putsf(0, 3, "Speedup: %d.%02dx", speedup / 100, speedup % 100);
+    rb->lcd_puts(0, 4, match ? "State matches" : "State differs!");
+    rb->lcd_update();
+
+    while (rb->button_get(false) != BUTTON_NONE)
+        rb->yield();
+    rb->button_get(true);
+}
@@ -52,4 +52,10 @@ void cpu_reset(void);
 void cpu_timers(int cnt) ICODE_ATTR;
 int cpu_emulate(int cycles) ICODE_ATTR;
 
+#ifdef THREADED_CPU
+/* false runs everything through the interpreter */
+extern bool cpu_translate;
+void cpu_bench(void);
+#endif
+
 #endif
@@ -22,7 +22,15 @@ bool plugbuf;
 #define PUSH(w) ( (SP -= 2), (writew(xSP, (w))) )
 #define POP(w) ( ((w) = readw(xSP)), (SP += 2) )
 
-#define FETCH (readb(PC++))
+/* Instruction stream reads almost always hit a mapped ROM or RAM page,
+ * so take that path inline and only call out for I/O */
+static inline byte fetchb(int a)
+{
+    byte *p = mbc.rmap[a>>12];
+    return p ? p[a] : mem_read(a);
+}
+
+#define FETCH (fetchb(PC++))
 
 
 #define INC(r) { ((r)++); \
@@ -204,7 +212,7 @@ label: op(b); break;
 
 
 
-#define JR ( PC += 1+(n8)readb(PC) )
+#define JR ( PC += 1+(n8)fetchb(PC) )
 #define JP ( PC = readw(PC) )
 
 #define CALL ( PUSH(PC+2), JP )
@@ -216,6 +224,42 @@ label: op(b); break;
 
 #define RST(n) { PUSH(PC); PC = (n); }
 
+#ifdef THREADED_CPU
+/* Translated instructions find PC past their operands already. A call
+ * takes the target it was translated with, where CALL above reads it
+ * again after the push. That only differs if the stack is over the MBC
+ * registers and the push switches banks, and the hardware reads the
+ * operand first, too. */
+#define TC_JR ( PC += (n8)o->imm )
+#define TC_CALL ( PUSH(PC), PC = o->imm )
+
+/* Ends a translated instruction. When no timer, lcdc or interrupt
+ * event is due and the block and the time slice go on, this does the
+ * cycle accounting of tc_done inline and jumps straight to the next
+ * handler, so each handler has a dispatch jump of its own for the host
+ * to predict. */
+#define TC_NEXT { \
+    clen <<= 1; \
+    if (cpu.div + (clen<<1) < 256 && cpu.lcdc > (clen >> cpu.speed) \
+        && i > (clen >> cpu.speed) && left > 1 && !(R_TAC & 0x04) \
+        && !(IME && (cpu.halt || (IF & IE)))) \
+    { \
+        cpu.div += clen<<1; \
+        clen >>= cpu.speed; \
+        cpu.lcdc -= clen; \
+        if(options.sound) \
+            sound_advance(clen); \
+        i -= clen; \
+        IME = IMA; \
+        left--; \
+        o++; \
+        PC += o->len; \
+        clen = o->clen; \
+        goto *o->handler; \
+    } \
+    goto tc_done; }
+#endif
+
 #define RET ( POP(PC) )
 
 #define EI ( IMA = 1 )
@@ -234,6 +278,123 @@ int blockcount;
 #define MAXBLOCK 6
 #endif
 
+#ifdef THREADED_CPU
+/* Threaded code: runs of ROM instructions are predecoded once into a
+ * chain of handler addresses and operands, which cpu_emulate() then
+ * steps through with computed gotos instead of fetching and switching
+ * on every opcode. Blocks are keyed by PC and by the read map of their
+ * page, so each ROM bank gets its own, and end at the first jump, call
+ * or return or at the end of the 4k page. Anything else (RAM, STOP,
+ * invalid opcodes) runs through the interpreter as before. */
+#define TC_BLOCKS 8192
+#define TC_OPS 65536
+#define TC_BLOCK_OPS 64
+#define TC_HASH_SIZE 4096
+#define TC_HASH(map, pc) \
+    (((pc) ^ ((uintptr_t)(map) >> 14)) & (TC_HASH_SIZE-1))
+
+struct tc_op
+{
+    const void *handler;
+    word imm;
+    byte len;
+    byte clen;
+};
+
+struct tc_block
+{
+    byte *map;
+    word pc;
+    int count;
+    struct tc_op *ops;
+    struct tc_block *next;
+    struct tc_block *link[2]; /* blocks last run after this one */
+};
+
+bool cpu_translate = true;
+static struct tc_op tc_ops[TC_OPS];
+static struct tc_block tc_blocks[TC_BLOCKS];
+static struct tc_block *tc_hash[TC_HASH_SIZE];
+static int tc_nops, tc_nblocks;
+
+/* A link or cached block is only followed if it was translated from
+ * the code now mapped at PC, so stale ones are harmless */
+#define TC_VALID(blk) ( (blk) && (blk)->pc == PC \
+                        && (blk)->map == mbc.rmap[PC>>12] )
+
+static void tc_flush(void)
+{
+    tc_nops = 0;
+    tc_nblocks = 0;
+    memset(tc_hash, 0, sizeof(tc_hash));
+}
+
+static struct tc_block *tc_translate(byte *map, word pc,
+                                     const void * const *handlers)
+{
+    struct tc_block *blk;
+    struct tc_op *o;
+    word a = pc;
+    int n, info;
+    byte op;
+
+    if (tc_nblocks == TC_BLOCKS || tc_nops > TC_OPS - TC_BLOCK_OPS)
+        tc_flush();
+    blk = &tc_blocks[tc_nblocks];
+    o = &tc_ops[tc_nops];
+    for (n = 0; n < TC_BLOCK_OPS; n++, o++)
+    {
+        op = map[a];
+        info = tc_info_table[op];
+        /* the operands must come from the same mapping */
+        if (!(info & TC_LEN) || ((a + (info & TC_LEN) - 1) ^ pc) & 0xF000)
+            break;
+        o->handler = handlers[op];
+        o->len = info & TC_LEN;
+        o->clen = cycles_table[op];
+        o->imm = 0;
+        if (o->len == 2)
+            o->imm = map[a+1];
+        else if (o->len == 3)
+            o->imm = map[a+1] | (map[a+2] << 8);
+        if (op == 0xCB)
+            o->clen = cb_cycles_table[o->imm];
+        a += o->len;
+        if ((info & TC_END) || ((a ^ pc) & 0xF000))
+        {
+            n++;
+            break;
+        }
+    }
+    if (!n)
+        return NULL;
+
+    blk->map = map;
+    blk->pc = pc;
+    blk->count = n;
+    blk->ops = &tc_ops[tc_nops];
+    blk->link[0] = blk->link[1] = NULL;
+    blk->next = tc_hash[TC_HASH(map, pc)];
+    tc_hash[TC_HASH(map, pc)] = blk;
+    tc_nops += n;
+    tc_nblocks++;
+    return blk;
+}
+
+static struct tc_block *tc_lookup(word pc, const void * const *handlers)
+{
+    byte *map = mbc.rmap[pc>>12];
+    struct tc_block *blk;
+
+    if (!map)
+        return NULL;
+    for (blk = tc_hash[TC_HASH(map, pc)]; blk; blk = blk->next)
+        if (blk->pc == pc && blk->map == map)
+            return blk;
+    return tc_translate(map, pc, handlers);
+}
+#endif
+
 
 
 void cpu_reset(void)
@@ -270,6 +431,9 @@ void cpu_reset(void)
     for(i=0;i<(1<<HASH_SIGNIFICANT_LOWER_BITS);i++)
         address_map[i]=0;
 #endif
+#ifdef THREADED_CPU
+    tc_flush();
+#endif
 }
 
 static void div_advance(int cnt) ICODE_ATTR;
@@ -377,6 +541,46 @@ int cpu_emulate(int cycles)
     static union reg acc IBSS_ATTR;
     static byte b IBSS_ATTR;
     static word w IBSS_ATTR;
+#ifdef THREADED_CPU
+    static const void * const tc_handlers[256] =
+    {
+        &&tc_00, &&tc_01, &&tc_02, &&tc_03, &&tc_04, &&tc_05, &&tc_06, &&tc_07,
+        &&tc_08, &&tc_09, &&tc_0A, &&tc_0B, &&tc_0C, &&tc_0D, &&tc_0E, &&tc_0F,
+        NULL, &&tc_11, &&tc_12, &&tc_13, &&tc_14, &&tc_15, &&tc_16, &&tc_17,
+        &&tc_18, &&tc_19, &&tc_1A, &&tc_1B, &&tc_1C, &&tc_1D, &&tc_1E, &&tc_1F,
+        &&tc_20, &&tc_21, &&tc_22, &&tc_23, &&tc_24, &&tc_25, &&tc_26, &&tc_27,
+        &&tc_28, &&tc_29, &&tc_2A, &&tc_2B, &&tc_2C, &&tc_2D, &&tc_2E, &&tc_2F,
+        &&tc_30, &&tc_31, &&tc_32, &&tc_33, &&tc_34, &&tc_35, &&tc_36, &&tc_37,
+        &&tc_38, &&tc_39, &&tc_3A, &&tc_3B, &&tc_3C, &&tc_3D, &&tc_3E, &&tc_3F,
+        &&tc_40, &&tc_41, &&tc_42, &&tc_43, &&tc_44, &&tc_45, &&tc_46, &&tc_47,
+        &&tc_48, &&tc_49, &&tc_4A, &&tc_4B, &&tc_4C, &&tc_4D, &&tc_4E, &&tc_4F,
+        &&tc_50, &&tc_51, &&tc_52, &&tc_53, &&tc_54, &&tc_55, &&tc_56, &&tc_57,
+        &&tc_58, &&tc_59, &&tc_5A, &&tc_5B, &&tc_5C, &&tc_5D, &&tc_5E, &&tc_5F,
+        &&tc_60, &&tc_61, &&tc_62, &&tc_63, &&tc_64, &&tc_65, &&tc_66, &&tc_67,
+        &&tc_68, &&tc_69, &&tc_6A, &&tc_6B, &&tc_6C, &&tc_6D, &&tc_6E, &&tc_6F,
+        &&tc_70, &&tc_71, &&tc_72, &&tc_73, &&tc_74, &&tc_75, &&tc_76, &&tc_77,
+        &&tc_78, &&tc_79, &&tc_7A, &&tc_7B, &&tc_7C, &&tc_7D, &&tc_7E, &&tc_7F,
+        &&tc_80, &&tc_81, &&tc_82, &&tc_83, &&tc_84, &&tc_85, &&tc_86, &&tc_87,
+        &&tc_88, &&tc_89, &&tc_8A, &&tc_8B, &&tc_8C, &&tc_8D, &&tc_8E, &&tc_8F,
+        &&tc_90, &&tc_91, &&tc_92, &&tc_93, &&tc_94, &&tc_95, &&tc_96, &&tc_97,
+        &&tc_98, &&tc_99, &&tc_9A, &&tc_9B, &&tc_9C, &&tc_9D, &&tc_9E, &&tc_9F,
+        &&tc_A0, &&tc_A1, &&tc_A2, &&tc_A3, &&tc_A4, &&tc_A5, &&tc_A6, &&tc_A7,
+        &&tc_A8, &&tc_A9, &&tc_AA, &&tc_AB, &&tc_AC, &&tc_AD, &&tc_AE, &&tc_AF,
+        &&tc_B0, &&tc_B1, &&tc_B2, &&tc_B3, &&tc_B4, &&tc_B5, &&tc_B6, &&tc_B7,
+        &&tc_B8, &&tc_B9, &&tc_BA, &&tc_BB, &&tc_BC, &&tc_BD, &&tc_BE, &&tc_BF,
+        &&tc_C0, &&tc_C1, &&tc_C2, &&tc_C3, &&tc_C4, &&tc_C5, &&tc_C6, &&tc_C7,
+        &&tc_C8, &&tc_C9, &&tc_CA, &&tc_CB, &&tc_CC, &&tc_CD, &&tc_CE, &&tc_CF,
+        &&tc_D0, &&tc_D1, &&tc_D2, NULL, &&tc_D4, &&tc_D5, &&tc_D6, &&tc_D7,
+        &&tc_D8, &&tc_D9, &&tc_DA, NULL, &&tc_DC, NULL, &&tc_DE, &&tc_DF,
+        &&tc_E0, &&tc_E1, &&tc_E2, NULL, NULL, &&tc_E5, &&tc_E6, &&tc_E7,
+        &&tc_E8, &&tc_E9, &&tc_EA, NULL, NULL, NULL, &&tc_EE, &&tc_EF,
+        &&tc_F0, &&tc_F1, &&tc_F2, &&tc_F3, NULL, &&tc_F5, &&tc_F6, &&tc_F7,
+        &&tc_F8, &&tc_F9, &&tc_FA, &&tc_FB, NULL, NULL, &&tc_FE, &&tc_FF,
+    };
+    struct tc_block *blk, *nblk;
+    const struct tc_op *o;
+    int left;
+#endif
 
     i = cycles;
 next:
@@ -415,6 +619,12 @@ next:
     IME = IMA;
     
 /*    if (debug_trace) debug_disassemble(PC, 1); */
+#ifdef THREADED_CPU
+    if (cpu_translate && !(PC & 0x8000)
+        && (blk = tc_lookup(PC, tc_handlers)))
+        goto tc_enter;
+tc_interp:
+#endif
 #ifdef DYNAREC
     if(PC&0x8000) {
 #endif
@@ -1015,6 +1225,564 @@ next:
     i -= clen;
     if (i > 0) goto next;
     return cycles-i;
+
+#ifdef THREADED_CPU
+    /* Translated code. Each handler is the interpreter case for its
+     * opcode, with PC already past the instruction and the operands
+     * taken from the op. tc_done does the same timing and interrupt
+     * checks between two instructions as above. */
+tc_enter:
+    o = blk->ops;
+    left = blk->count;
+tc_dispatch:
+    PC += o->len;
+    clen = o->clen;
+    goto *o->handler;
+
+    tc_00: /* NOP */
+    tc_40: /* LD B,B */
+    tc_49: /* LD C,C */
+    tc_52: /* LD D,D */
+    tc_5B: /* LD E,E */
+    tc_64: /* LD H,H */
+    tc_6D: /* LD L,L */
+    tc_7F: /* LD A,A */
+        TC_NEXT;
+    tc_01: /* LD BC,imm */
+        BC = o->imm; TC_NEXT;
+    tc_02: /* LD (BC),A */
+        writeb(xBC, A); goto tc_wdone;
+    tc_03: /* INC BC */
+        INCW(BC); TC_NEXT;
+    tc_04: /* INC B */
+        INC(B); TC_NEXT;
+    tc_05: /* DEC B */
+        DEC(B); TC_NEXT;
+    tc_06: /* LD B,imm */
+        B = o->imm; TC_NEXT;
+    tc_07: /* RLCA */
+        RLCA(A); TC_NEXT;
+    tc_08: /* LD (imm),SP */
+        writew(o->imm, SP); goto tc_wdone;
+    tc_09: /* ADD HL,BC */
+        w = BC; ADDW(w); TC_NEXT;
+    tc_0A: /* LD A,(BC) */
+        A = readb(xBC); TC_NEXT;
+    tc_0B: /* DEC BC */
+        DECW(BC); TC_NEXT;
+    tc_0C: /* INC C */
+        INC(C); TC_NEXT;
+    tc_0D: /* DEC C */
+        DEC(C); TC_NEXT;
+    tc_0E: /* LD C,imm */
+        C = o->imm; TC_NEXT;
+    tc_0F: /* RRCA */
+        RRCA(A); TC_NEXT;
+    tc_11: /* LD DE,imm */
+        DE = o->imm; TC_NEXT;
+    tc_12: /* LD (DE),A */
+        writeb(xDE, A); goto tc_wdone;
+    tc_13: /* INC DE */
+        INCW(DE); TC_NEXT;
+    tc_14: /* INC D */
+        INC(D); TC_NEXT;
+    tc_15: /* DEC D */
+        DEC(D); TC_NEXT;
+    tc_16: /* LD D,imm */
+        D = o->imm; TC_NEXT;
+    tc_17: /* RLA */
+        RLA(A); TC_NEXT;
+    tc_18: /* JR */
+        TC_JR; TC_NEXT;
+    tc_19: /* ADD HL,DE */
+        w = DE; ADDW(w); TC_NEXT;
+    tc_1A: /* LD A,(DE) */
+        A = readb(xDE); TC_NEXT;
+    tc_1B: /* DEC DE */
+        DECW(DE); TC_NEXT;
+    tc_1C: /* INC E */
+        INC(E); TC_NEXT;
+    tc_1D: /* DEC E */
+        DEC(E); TC_NEXT;
+    tc_1E: /* LD E,imm */
+        E = o->imm; TC_NEXT;
+    tc_1F: /* RRA */
+        RRA(A); TC_NEXT;
+    tc_20: /* JR NZ */
+        if (!(F&FZ)) TC_JR; else clen--; TC_NEXT;
+    tc_21: /* LD HL,imm */
+        HL = o->imm; TC_NEXT;
+    tc_22: /* LDI (HL),A */
+        writeb(xHL, A); HL++; goto tc_wdone;
+    tc_23: /* INC HL */
+        INCW(HL); TC_NEXT;
+    tc_24: /* INC H */
+        INC(H); TC_NEXT;
+    tc_25: /* DEC H */
+        DEC(H); TC_NEXT;
+    tc_26: /* LD H,imm */
+        H = o->imm; TC_NEXT;
+    tc_27: /* DAA */
+        DAA; TC_NEXT;
+    tc_28: /* JR Z */
+        if (F&FZ) TC_JR; else clen--; TC_NEXT;
+    tc_29: /* ADD HL,HL */
+        w = HL; ADDW(w); TC_NEXT;
+    tc_2A: /* LDI A,(HL) */
+        A = readb(xHL); HL++; TC_NEXT;
+    tc_2B: /* DEC HL */
+        DECW(HL); TC_NEXT;
+    tc_2C: /* INC L */
+        INC(L); TC_NEXT;
+    tc_2D: /* DEC L */
+        DEC(L); TC_NEXT;
+    tc_2E: /* LD L,imm */
+        L = o->imm; TC_NEXT;
+    tc_2F: /* CPL */
+        CPL(A); TC_NEXT;
+    tc_30: /* JR NC */
+        if (!(F&FC)) TC_JR; else clen--; TC_NEXT;
+    tc_31: /* LD SP,imm */
+        SP = o->imm; TC_NEXT;
+    tc_32: /* LDD (HL),A */
+        writeb(xHL, A); HL--; goto tc_wdone;
+    tc_33: /* INC SP */
+        INCW(SP); TC_NEXT;
+    tc_34: /* INC (HL) */
+        b = readb(xHL); INC(b); writeb(xHL, b); goto tc_wdone;
+    tc_35: /* DEC (HL) */
+        b = readb(xHL); DEC(b); writeb(xHL, b); goto tc_wdone;
+    tc_36: /* LD (HL),imm */
+        writeb(xHL, o->imm); goto tc_wdone;
+    tc_37: /* SCF */
+        SCF; TC_NEXT;
+    tc_38: /* JR C */
+        if (F&FC) TC_JR; else clen--; TC_NEXT;
+    tc_39: /* ADD HL,SP */
+        w = SP; ADDW(w); TC_NEXT;
+    tc_3A: /* LDD A,(HL) */
+        A = readb(xHL); HL--; TC_NEXT;
+    tc_3B: /* DEC SP */
+        DECW(SP); TC_NEXT;
+    tc_3C: /* INC A */
+        INC(A); TC_NEXT;
+    tc_3D: /* DEC A */
+        DEC(A); TC_NEXT;
+    tc_3E: /* LD A,imm */
+        A = o->imm; TC_NEXT;
+    tc_3F: /* CCF */
+        CCF; TC_NEXT;
+    tc_41: /* LD B,C */
+        B = C; TC_NEXT;
+    tc_42: /* LD B,D */
+        B = D; TC_NEXT;
+    tc_43: /* LD B,E */
+        B = E; TC_NEXT;
+    tc_44: /* LD B,H */
+        B = H; TC_NEXT;
+    tc_45: /* LD B,L */
+        B = L; TC_NEXT;
+    tc_46: /* LD B,(HL) */
+        B = readb(xHL); TC_NEXT;
+    tc_47: /* LD B,A */
+        B = A; TC_NEXT;
+    tc_48: /* LD C,B */
+        C = B; TC_NEXT;
+    tc_4A: /* LD C,D */
+        C = D; TC_NEXT;
+    tc_4B: /* LD C,E */
+        C = E; TC_NEXT;
+    tc_4C: /* LD C,H */
+        C = H; TC_NEXT;
+    tc_4D: /* LD C,L */
+        C = L; TC_NEXT;
+    tc_4E: /* LD C,(HL) */
+        C = readb(xHL); TC_NEXT;
+    tc_4F: /* LD C,A */
+        C = A; TC_NEXT;
+    tc_50: /* LD D,B */
+        D = B; TC_NEXT;
+    tc_51: /* LD D,C */
+        D = C; TC_NEXT;
+    tc_53: /* LD D,E */
+        D = E; TC_NEXT;
+    tc_54: /* LD D,H */
+        D = H; TC_NEXT;
+    tc_55: /* LD D,L */
+        D = L; TC_NEXT;
+    tc_56: /* LD D,(HL) */
+        D = readb(xHL); TC_NEXT;
+    tc_57: /* LD D,A */
+        D = A; TC_NEXT;
+    tc_58: /* LD E,B */
+        E = B; TC_NEXT;
+    tc_59: /* LD E,C */
+        E = C; TC_NEXT;
+    tc_5A: /* LD E,D */
+        E = D; TC_NEXT;
+    tc_5C: /* LD E,H */
+        E = H; TC_NEXT;
+    tc_5D: /* LD E,L */
+        E = L; TC_NEXT;
+    tc_5E: /* LD E,(HL) */
+        E = readb(xHL); TC_NEXT;
+    tc_5F: /* LD E,A */
+        E = A; TC_NEXT;
+    tc_60: /* LD H,B */
+        H = B; TC_NEXT;
+    tc_61: /* LD H,C */
+        H = C; TC_NEXT;
+    tc_62: /* LD H,D */
+        H = D; TC_NEXT;
+    tc_63: /* LD H,E */
+        H = E; TC_NEXT;
+    tc_65: /* LD H,L */
+        H = L; TC_NEXT;
+    tc_66: /* LD H,(HL) */
+        H = readb(xHL); TC_NEXT;
+    tc_67: /* LD H,A */
+        H = A; TC_NEXT;
+    tc_68: /* LD L,B */
+        L = B; TC_NEXT;
+    tc_69: /* LD L,C */
+        L = C; TC_NEXT;
+    tc_6A: /* LD L,D */
+        L = D; TC_NEXT;
+    tc_6B: /* LD L,E */
+        L = E; TC_NEXT;
+    tc_6C: /* LD L,H */
+        L = H; TC_NEXT;
+    tc_6E: /* LD L,(HL) */
+        L = readb(xHL); TC_NEXT;
+    tc_6F: /* LD L,A */
+        L = A; TC_NEXT;
+    tc_70: /* LD (HL),B */
+        writeb(xHL, B); goto tc_wdone;
+    tc_71: /* LD (HL),C */
+        writeb(xHL, C); goto tc_wdone;
+    tc_72: /* LD (HL),D */
+        writeb(xHL, D); goto tc_wdone;
+    tc_73: /* LD (HL),E */
+        writeb(xHL, E); goto tc_wdone;
+    tc_74: /* LD (HL),H */
+        writeb(xHL, H); goto tc_wdone;
+    tc_75: /* LD (HL),L */
+        writeb(xHL, L); goto tc_wdone;
+    tc_76: /* HALT */
+        cpu.halt = 1; TC_NEXT;
+    tc_77: /* LD (HL),A */
+        writeb(xHL, A); goto tc_wdone;
+    tc_78: /* LD A,B */
+        A = B; TC_NEXT;
+    tc_79: /* LD A,C */
+        A = C; TC_NEXT;
+    tc_7A: /* LD A,D */
+        A = D; TC_NEXT;
+    tc_7B: /* LD A,E */
+        A = E; TC_NEXT;
+    tc_7C: /* LD A,H */
+        A = H; TC_NEXT;
+    tc_7D: /* LD A,L */
+        A = L; TC_NEXT;
+    tc_7E: /* LD A,(HL) */
+        A = readb(xHL); TC_NEXT;
+    tc_80: /* ADD B */
+        ADD(B); TC_NEXT;
+    tc_81: /* ADD C */
+        ADD(C); TC_NEXT;
+    tc_82: /* ADD D */
+        ADD(D); TC_NEXT;
+    tc_83: /* ADD E */
+        ADD(E); TC_NEXT;
+    tc_84: /* ADD H */
+        ADD(H); TC_NEXT;
+    tc_85: /* ADD L */
+        ADD(L); TC_NEXT;
+    tc_86: /* ADD (HL) */
+        b = readb(xHL); ADD(b); TC_NEXT;
+    tc_87: /* ADD A */
+        ADD(A); TC_NEXT;
+    tc_88: /* ADC B */
+        ADC(B); TC_NEXT;
+    tc_89: /* ADC C */
+        ADC(C); TC_NEXT;
+    tc_8A: /* ADC D */
+        ADC(D); TC_NEXT;
+    tc_8B: /* ADC E */
+        ADC(E); TC_NEXT;
+    tc_8C: /* ADC H */
+        ADC(H); TC_NEXT;
+    tc_8D: /* ADC L */
+        ADC(L); TC_NEXT;
+    tc_8E: /* ADC (HL) */
+        b = readb(xHL); ADC(b); TC_NEXT;
+    tc_8F: /* ADC A */
+        ADC(A); TC_NEXT;
+    tc_90: /* SUB B */
+        SUB(B); TC_NEXT;
+    tc_91: /* SUB C */
+        SUB(C); TC_NEXT;
+    tc_92: /* SUB D */
+        SUB(D); TC_NEXT;
+    tc_93: /* SUB E */
+        SUB(E); TC_NEXT;
+    tc_94: /* SUB H */
+        SUB(H); TC_NEXT;
+    tc_95: /* SUB L */
+        SUB(L); TC_NEXT;
+    tc_96: /* SUB (HL) */
+        b = readb(xHL); SUB(b); TC_NEXT;
+    tc_97: /* SUB A */
+        SUB(A); TC_NEXT;
+    tc_98: /* SBC B */
+        SBC(B); TC_NEXT;
+    tc_99: /* SBC C */
+        SBC(C); TC_NEXT;
+    tc_9A: /* SBC D */
+        SBC(D); TC_NEXT;
+    tc_9B: /* SBC E */
+        SBC(E); TC_NEXT;
+    tc_9C: /* SBC H */
+        SBC(H); TC_NEXT;
+    tc_9D: /* SBC L */
+        SBC(L); TC_NEXT;
+    tc_9E: /* SBC (HL) */
+        b = readb(xHL); SBC(b); TC_NEXT;
+    tc_9F: /* SBC A */
+        SBC(A); TC_NEXT;
+    tc_A0: /* AND B */
+        AND(B); TC_NEXT;
+    tc_A1: /* AND C */
+        AND(C); TC_NEXT;
+    tc_A2: /* AND D */
+        AND(D); TC_NEXT;
+    tc_A3: /* AND E */
+        AND(E); TC_NEXT;
+    tc_A4: /* AND H */
+        AND(H); TC_NEXT;
+    tc_A5: /* AND L */
+        AND(L); TC_NEXT;
+    tc_A6: /* AND (HL) */
+        b = readb(xHL); AND(b); TC_NEXT;
+    tc_A7: /* AND A */
+        AND(A); TC_NEXT;
+    tc_A8: /* XOR B */
+        XOR(B); TC_NEXT;
+    tc_A9: /* XOR C */
+        XOR(C); TC_NEXT;
+    tc_AA: /* XOR D */
+        XOR(D); TC_NEXT;
+    tc_AB: /* XOR E */
+        XOR(E); TC_NEXT;
+    tc_AC: /* XOR H */
+        XOR(H); TC_NEXT;
+    tc_AD: /* XOR L */
+        XOR(L); TC_NEXT;
+    tc_AE: /* XOR (HL) */
+        b = readb(xHL); XOR(b); TC_NEXT;
+    tc_AF: /* XOR A */
+        XOR(A); TC_NEXT;
+    tc_B0: /* OR B */
+        OR(B); TC_NEXT;
+    tc_B1: /* OR C */
+        OR(C); TC_NEXT;
+    tc_B2: /* OR D */
+        OR(D); TC_NEXT;
+    tc_B3: /* OR E */
+        OR(E); TC_NEXT;
+    tc_B4: /* OR H */
+        OR(H); TC_NEXT;
+    tc_B5: /* OR L */
+        OR(L); TC_NEXT;
+    tc_B6: /* OR (HL) */
+        b = readb(xHL); OR(b); TC_NEXT;
+    tc_B7: /* OR A */
+        OR(A); TC_NEXT;
+    tc_B8: /* CP B */
+        CP(B); TC_NEXT;
+    tc_B9: /* CP C */
+        CP(C); TC_NEXT;
+    tc_BA: /* CP D */
+        CP(D); TC_NEXT;
+    tc_BB: /* CP E */
+        CP(E); TC_NEXT;
+    tc_BC: /* CP H */
+        CP(H); TC_NEXT;
+    tc_BD: /* CP L */
+        CP(L); TC_NEXT;
+    tc_BE: /* CP (HL) */
+        b = readb(xHL); CP(b); TC_NEXT;
+    tc_BF: /* CP A */
+        CP(A); TC_NEXT;
+    tc_C0: /* RET NZ */
+        if (!(F&FZ)) RET; else NORET; TC_NEXT;
+    tc_C1: /* POP BC */
+        POP(BC); TC_NEXT;
+    tc_C2: /* JP NZ */
+        if (!(F&FZ)) PC = o->imm; else clen--; TC_NEXT;
+    tc_C3: /* JP */
+        PC = o->imm; TC_NEXT;
+    tc_C4: /* CALL NZ */
+        if (!(F&FZ)) TC_CALL; else clen -= 3; TC_NEXT;
+    tc_C5: /* PUSH BC */
+        PUSH(BC); goto tc_wdone;
+    tc_C6: /* ADD imm */
+        b = o->imm; ADD(b); TC_NEXT;
+    tc_C7: /* RST 0 */
+        RST(0x00); TC_NEXT;
+    tc_C8: /* RET Z */
+        if (F&FZ) RET; else NORET; TC_NEXT;
+    tc_C9: /* RET */
+        RET; TC_NEXT;
+    tc_CA: /* JP Z */
+        if (F&FZ) PC = o->imm; else clen--; TC_NEXT;
+    tc_CB: /* CB prefix */
+        cbop = o->imm;
+        switch (cbop)
+        {
+            CB_REG_CASES(B, 0);
+            CB_REG_CASES(C, 1);
+            CB_REG_CASES(D, 2);
+            CB_REG_CASES(E, 3);
+            CB_REG_CASES(H, 4);
+            CB_REG_CASES(L, 5);
+            CB_REG_CASES(A, 7);
+        default:
+            b = readb(xHL);
+            switch(cbop)
+            {
+                CB_REG_CASES(b, 6);
+            }
+            if ((cbop & 0xC0) != 0x40) /* exclude BIT */
+                writeb(xHL, b);
+            break;
+        }
+        goto tc_wdone;
+    tc_CC: /* CALL Z */
+        if (F&FZ) TC_CALL; else clen -= 3; TC_NEXT;
+    tc_CD: /* CALL */
+        TC_CALL; TC_NEXT;
+    tc_CE: /* ADC imm */
+        b = o->imm; ADC(b); TC_NEXT;
+    tc_CF: /* RST 8 */
+        RST(0x08); TC_NEXT;
+    tc_D0: /* RET NC */
+        if (!(F&FC)) RET; else NORET; TC_NEXT;
+    tc_D1: /* POP DE */
+        POP(DE); TC_NEXT;
+    tc_D2: /* JP NC */
+        if (!(F&FC)) PC = o->imm; else clen--; TC_NEXT;
+    tc_D4: /* CALL NC */
+        if (!(F&FC)) TC_CALL; else clen -= 3; TC_NEXT;
+    tc_D5: /* PUSH DE */
+        PUSH(DE); goto tc_wdone;
+    tc_D6: /* SUB imm */
+        b = o->imm; SUB(b); TC_NEXT;
+    tc_D7: /* RST 10 */
+        RST(0x10); TC_NEXT;
+    tc_D8: /* RET C */
+        if (F&FC) RET; else NORET; TC_NEXT;
+    tc_D9: /* RETI */
+        IME = IMA = 1; RET; TC_NEXT;
+    tc_DA: /* JP C */
+        if (F&FC) PC = o->imm; else clen--; TC_NEXT;
+    tc_DC: /* CALL C */
+        if (F&FC) TC_CALL; else clen -= 3; TC_NEXT;
+    tc_DE: /* SBC imm */
+        b = o->imm; SBC(b); TC_NEXT;
+    tc_DF: /* RST 18 */
+        RST(0x18); TC_NEXT;
+    tc_E0: /* LDH (imm),A */
+        writehi(o->imm, A); goto tc_wdone;
+    tc_E1: /* POP HL */
+        POP(HL); TC_NEXT;
+    tc_E2: /* LDH (C),A */
+        writehi(C, A); goto tc_wdone;
+    tc_E5: /* PUSH HL */
+        PUSH(HL); goto tc_wdone;
+    tc_E6: /* AND imm */
+        b = o->imm; AND(b); TC_NEXT;
+    tc_E7: /* RST 20 */
+        RST(0x20); TC_NEXT;
+    tc_E8: /* ADD SP,imm */
+        b = o->imm; ADDSP(b); TC_NEXT;
+    tc_E9: /* JP HL */
+        PC = HL; TC_NEXT;
+    tc_EA: /* LD (imm),A */
+        writeb(o->imm, A); goto tc_wdone;
+    tc_EE: /* XOR imm */
+        b = o->imm; XOR(b); TC_NEXT;
+    tc_EF: /* RST 28 */
+        RST(0x28); TC_NEXT;
+    tc_F0: /* LDH A,(imm) */
+        A = readhi(o->imm); TC_NEXT;
+    tc_F1: /* POP AF */
+        POP(AF); TC_NEXT;
+    tc_F2: /* LDH A,(C) (undocumented) */
+        A = readhi(C); TC_NEXT;
+    tc_F3: /* DI */
+        DI; TC_NEXT;
+    tc_F5: /* PUSH AF */
+        PUSH(AF); goto tc_wdone;
+    tc_F6: /* OR imm */
+        b = o->imm; OR(b); TC_NEXT;
+    tc_F7: /* RST 30 */
+        RST(0x30); TC_NEXT;
+    tc_F8: /* LD HL,SP+imm */
+        b = o->imm; LDHLSP(b); TC_NEXT;
+    tc_F9: /* LD SP,HL */
+        SP = HL; TC_NEXT;
+    tc_FA: /* LD A,(imm) */
+        A = readb(o->imm); TC_NEXT;
+    tc_FB: /* EI */
+        EI; TC_NEXT;
+    tc_FE: /* CP imm */
+        b = o->imm; CP(b); TC_NEXT;
+    tc_FF: /* RST 38 */
+        RST(0x38); TC_NEXT;
+
+tc_wdone:
+    /* leave the block if the write switched its bank away */
+    if (mbc.rmap[blk->pc>>12] != blk->map)
+        left = 1;
+    TC_NEXT;
+tc_done:
+    /* clen has been doubled by TC_NEXT */
+    div_advance(clen);
+    timer_advance(clen);
+    clen >>= cpu.speed;
+    lcdc_advance(clen);
+    if(options.sound)
+        sound_advance(clen);
+
+    i -= clen;
+    if (i <= 0)
+        return cycles-i;
+    /* halting and taking interrupts is left to the interpreter */
+    if (IME && (cpu.halt || (IF & IE)))
+        goto next;
+    IME = IMA;
+    if (--left)
+    {
+        o++;
+        goto tc_dispatch;
+    }
+
+    /* try the blocks that followed this one before, then the cache */
+    nblk = blk->link[0];
+    if (!TC_VALID(nblk))
+    {
+        nblk = blk->link[1];
+        if (!TC_VALID(nblk))
+        {
+            if ((PC & 0x8000) || !(nblk = tc_lookup(PC, tc_handlers)))
+                goto tc_interp;
+            blk->link[blk->link[0] != NULL] = nblk;
+        }
+    }
+    blk = nblk;
+    goto tc_enter;
+#endif
 }
 
 #endif /* ASM_CPU_EMULATE */
@@ -48,6 +48,37 @@ static const byte cb_cycles_table[256] ICONST_ATTR =
     2, 2, 2, 2, 2, 2, 4, 2, 2, 2, 2, 2, 2, 2, 4, 2,
 };
 
+#ifdef THREADED_CPU
+/* Instruction lengths for the translator in cpu.c, 0 for opcodes it
+ * leaves to the interpreter. TC_END marks the jumps, calls and returns
+ * a translated block ends with */
+#define TC_LEN 0x03
+#define TC_END 0x80
+
+static const byte tc_info_table[256] =
+{
+    0x01, 0x03, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01,
+    0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x82, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01,
+    0x82, 0x03, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x82, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01,
+    0x82, 0x03, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x82, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01,
+    
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    
+    0x81, 0x01, 0x83, 0x83, 0x83, 0x01, 0x02, 0x81, 0x81, 0x81, 0x83, 0x02, 0x83, 0x83, 0x02, 0x81,
+    0x81, 0x01, 0x83, 0x00, 0x83, 0x01, 0x02, 0x81, 0x81, 0x81, 0x83, 0x00, 0x83, 0x00, 0x02, 0x81,
+    0x02, 0x01, 0x01, 0x00, 0x00, 0x01, 0x02, 0x81, 0x02, 0x81, 0x03, 0x00, 0x00, 0x00, 0x02, 0x81,
+    0x02, 0x01, 0x01, 0x01, 0x00, 0x01, 0x02, 0x81, 0x02, 0x01, 0x03, 0x01, 0x00, 0x00, 0x02, 0x81,
+};
+#endif
+
 static const byte incflag_table[256] ICONST_ATTR =
 {
     FZ|FH, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
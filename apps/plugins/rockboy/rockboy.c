@@ -25,6 +25,7 @@
 #include "input.h"
 #include "emu.h"
 #include "hw.h"
+#include "cpu-gb.h"
 #include "pcm.h"
 
 int shut,cleanshut;
@@ -590,7 +591,14 @@ enum plugin_status plugin_start(const void* parameter)
 
     if (!parameter)
     {
+#ifdef THREADED_CPU
+        MENUITEM_STRINGLIST(menu, "Play gameboy ROM file! (.gb/.gbc)", NULL,
+                            "CPU Benchmark", "Quit");
+        if (rb->do_menu(&menu, NULL, NULL, false) == 0)
+            cpu_bench();
+#else
         rb->splash(HZ*3, "Play gameboy ROM file! (.gb/.gbc)");
+#endif
         return PLUGIN_OK;
     }
     if(rb->audio_status())
@@ -44,6 +44,13 @@ extern struct dynarec_block newblock;
 void dynamic_recompile (struct dynarec_block *newblock);
 #endif
 
+/* Hosted builds run ROM code through the threaded-code translator in
+ * cpu.c. It relies on GCC's computed gotos and keeps a cache of
+ * predecoded blocks that is too big for the targets */
+#if (CONFIG_PLATFORM & PLATFORM_HOSTED) && !defined(DYNAREC)
+#define THREADED_CPU
+#endif
+
 #define USER_MENU_QUIT -2
 
 /* Disable IBSS when using dynarec since it won't fit */
@@ -1141,7 +1141,7 @@ static bool browse_fonts( char *dst, int dst_size )
 #define PREVIEW_NEXT(x) (struct font_preview *)((char*)(x) + PREVIEW_SIZE(x))
 
     struct tree_context backup;
-    struct entry *dc, *e;
+    struct entry *e;
     int dirfilter = SHOW_FONT;
 
     struct font_preview {
@@ -1178,13 +1178,15 @@ static bool browse_fonts( char *dst, int dst_size )
 
     tree = rb->tree_get_context();
     backup = *tree;
-    dc = rb->tree_get_entries(tree);
     a = backup.currdir+rb->strlen(backup.currdir)-1;
     if( *a != '/' )
     {
         *++a = '/';
     }
-    rb->strcpy( a+1, dc[tree->selected_item].name );
+    /* entries are looked up by list position, which loads the page of a
+     * folder too big for the tree's cache */
+    e = rb->tree_get_entry_at( tree, tree->selected_item );
+    rb->strcpy( a+1, e ? e->name : "" );
     tree->dirfilter = &dirfilter;
     tree->browse = NULL;
     rb->strcpy( bbuf, FONT_DIR "/" );
@@ -1238,9 +1240,11 @@ static bool browse_fonts( char *dst, int dst_size )
             i = fvi;
 
             cp = top;
-            while( cp <= LCD_HEIGHT+LINE_SPACE && i < tree->filesindir )
+            while( cp <= LCD_HEIGHT+LINE_SPACE && i < tree->dirlength )
             {
-                e = &dc[i];
+                e = rb->tree_get_entry_at( tree, i );
+                if( !e )
+                    break;
                 if( i < cache_first || i > cache_last )
                 {
                     size_t siz;
@@ -1309,17 +1313,17 @@ static bool browse_fonts( char *dst, int dst_size )
                 font_preview = PREVIEW_NEXT(font_preview);
             }
             lvi = i-1;
-            li = tree->filesindir-1;
+            li = tree->dirlength-1;
             if( reset_font )
             {
              // fixme   rb->font_load(NULL, bbuf_s );
                 reset_font = false;
             }
-            if( lvi-fvi+1 < tree->filesindir )
+            if( lvi-fvi+1 < tree->dirlength )
             {
                 rb->gui_scrollbar_draw( rb->screens[SCREEN_MAIN], 0, top,
                                        9, LCD_HEIGHT-top,
-                                       tree->filesindir, fvi, lvi+1, VERTICAL );
+                                       tree->dirlength, fvi, lvi+1, VERTICAL );
             }
         }
 
@@ -1367,8 +1371,11 @@ static bool browse_fonts( char *dst, int dst_size )
 
             case ROCKPAINT_RIGHT:
             case ROCKPAINT_DRAW:
+                e = rb->tree_get_entry_at( tree, si );
+                if( !e )
+                    break;
                 ret = true;
-                rb->snprintf( dst, dst_size, FONT_DIR "/%s", dc[si].name );
+                rb->snprintf( dst, dst_size, FONT_DIR "/%s", e->name );
                 /* fall through */
             case ROCKPAINT_LEFT:
             case ROCKPAINT_QUIT:
@@ -230,6 +230,12 @@ static unsigned char * const yuvbuf[3] = {
     (void*)vdata
 };
 
+/* Conversion rate in 1/100 megapixels per second */
+static int calc_mpix_rate(int tenth_fps, int width, int height)
+{
+    return (long long)tenth_fps * width * height / 100000;
+}
+
 static void make_gradient_rect(int width, int height)
 {
     unsigned char vline[YUV_WIDTH/2];
@@ -253,7 +259,7 @@ static void time_main_yuv(void)
     long time_start;  /* start tickcount */
     long time_end;    /* end tickcount */
     int frame_count;
-    int fps;
+    int fps, mpix;
 
     const int part14_x = YUV_WIDTH/4;   /* x-offset for 1/4 update test */
     const int part14_w = YUV_WIDTH/2;   /* x-size for 1/4 update test */
@@ -278,7 +284,9 @@ static void time_main_yuv(void)
         frame_count++;
     }
     fps = calc_tenth_fps(frame_count, time_end - time_start);
-    rb->snprintf(str, sizeof(str), "1/1: %d.%d fps", fps / 10, fps % 10);
+    mpix = calc_mpix_rate(fps, YUV_WIDTH, YUV_HEIGHT);
+    rb->snprintf(str, sizeof(str), "1/1: %d.%d fps, %d.%02d Mpx/s",
+                 fps / 10, fps % 10, mpix / 100, mpix % 100);
     log_text(str);
 
     /* Test 2: quarter LCD update */
@@ -294,7 +302,9 @@ static void time_main_yuv(void)
         frame_count++;
     }
     fps = calc_tenth_fps(frame_count, time_end - time_start);
-    rb->snprintf(str, sizeof(str), "1/4: %d.%d fps", fps / 10, fps % 10);
+    mpix = calc_mpix_rate(fps, part14_w, part14_h);
+    rb->snprintf(str, sizeof(str), "1/4: %d.%d fps, %d.%02d Mpx/s",
+                 fps / 10, fps % 10, mpix / 100, mpix % 100);
     log_text(str);
 }
 #endif
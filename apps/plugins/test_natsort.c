@@ -0,0 +1,138 @@
+/***************************************************************************
+*             __________               __   ___.
+*   Open      \______   \ ____   ____ |  | _\_ |__   _______  ___
+*   Source     |       _//  _ \_/ ___\|  |/ /| __ \ /  _ \  \/  /
+*   Jukebox    |    |   (  <_> )  \___|    < | \_\ (  <_> > <  <
+*   Firmware   |____|_  /\____/ \___  >__|_ \|___  /\____/__/\_ \
+*                     \/            \/     \/    \/            \/
+* $Id$
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF ANY
+* KIND, either express or implied.
+*
+****************************************************************************/
+
+#include "plugin.h"
+
+/* Checks that sorting by strnatkey() keys gives the order of
+ * strnatcasecmp(), which the file browser and the database rely on. For
+ * every pair of names with different keys, strcmp() of the keys has to
+ * agree with strnatcasecmp() of the names. Names with equal keys are
+ * ordered by strnatcasecmp() itself, so they aren't checked. The size
+ * strnatkey() returns without a buffer has to match the key it writes.
+ *
+ * Combining diacritics are left out on purpose: the keys drop them, so
+ * names which only differ in those sort differently than with
+ * strnatcasecmp(). */
+
+static const char * const names[] =
+{
+    /* leading zeros compare left-aligned */
+    "0", "00", "007", "0070", "01", "001", "02", "010", "0.5", "0.05",
+    /* other digit runs compare by value */
+    "1", "7", "9", "10", "70", "100", "1a", "1A",
+    "12345678901234567890", "12345678901234567891", "99999999999999999999",
+    /* runs within names */
+    "a", "A", "ab", "a b", "a.b", "a-b",
+    "a1", "a01", "a2", "a02", "a10", "a010", "a1b", "a01b", "a1.2", "a1.10",
+    "x9y", "x10y", "x009y", "v1.02", "v1.1", "v1.010",
+    "track 2", "track 02", "track 10", "track 010",
+};
+
+#define RANDOM_NAMES    200
+#define RANDOM_LEN      6
+#define KEY_SIZE        64
+
+static char random_names[RANDOM_NAMES][RANDOM_LEN + 1];
+static int mismatches;
+static int line;
+
+static int sign(int x)
+{
+    return (x > 0) - (x < 0);
+}
+
+static void check_size(const char *name)
+{
+    char key[KEY_SIZE];
+    size_t size = rb->strnatkey(NULL, name, true);
+
+    if (size != rb->strnatkey(key, name, true) || size != rb->strlen(key) + 1)
+    {
+        if (mismatches++ < 8)
+            rb->lcd_putsf(0, line++, "'%s': size %d", name, (int)size);
+        DEBUGF("'%s': strnatkey() size %d\n", name, (int)size);
+    }
+}
+
+static void check_pair(const char *a, const char *b)
+{
+    char key_a[KEY_SIZE], key_b[KEY_SIZE];
+    int key_order, nat_order;
+
+    rb->strnatkey(key_a, a, true);
+    rb->strnatkey(key_b, b, true);
+    key_order = sign(rb->strcmp(key_a, key_b));
+    if (key_order == 0)
+        return;
+
+    nat_order = sign(rb->strnatcasecmp(a, b));
+    if (key_order != nat_order)
+    {
+        if (mismatches++ < 8)
+            rb->lcd_putsf(0, line++, "'%s' '%s': %d, %d",
+                          a, b, key_order, nat_order);
+        DEBUGF("'%s' '%s': key %d, strnatcasecmp %d\n",
+               a, b, key_order, nat_order);
+    }
+}
+
+enum plugin_status plugin_start(const void* parameter)
+{
+    (void)parameter;
+    /* leading zeros and digit runs against letters and separators */
+    static const char chars[] = "0019aA .-";
+    int pairs = 0;
+    int i, j;
+
+    rb->lcd_setfont(FONT_SYSFIXED);
+    rb->lcd_clear_display();
+    line = 0;
+    mismatches = 0;
+
+    for (i = 0; i < (int)ARRAYLEN(names); i++)
+    {
+        check_size(names[i]);
+        for (j = 0; j < (int)ARRAYLEN(names); j++)
+            check_pair(names[i], names[j]);
+        pairs += ARRAYLEN(names);
+    }
+
+    rb->srand(1);
+    for (i = 0; i < RANDOM_NAMES; i++)
+    {
+        int len = 1 + rb->rand() % RANDOM_LEN;
+        for (j = 0; j < len; j++)
+            random_names[i][j] = chars[rb->rand() % (sizeof(chars) - 1)];
+        random_names[i][len] = '\0';
+    }
+
+    for (i = 0; i < RANDOM_NAMES; i++)
+    {
+        check_size(random_names[i]);
+        for (j = 0; j < RANDOM_NAMES; j++)
+            check_pair(random_names[i], random_names[j]);
+        pairs += RANDOM_NAMES;
+    }
+
+    rb->lcd_putsf(0, line++, "%d pairs, %d mismatches", pairs, mismatches);
+    rb->lcd_update();
+    rb->action_userabort(TIMEOUT_BLOCK);
+
+    return mismatches ? PLUGIN_ERROR : PLUGIN_OK;
+}
@@ -34,6 +34,21 @@
 
 static unsigned char pager_buffer[4 * TV_MAX_PAGE];
 
+/*
+ * the page index of the last read file is kept between sessions, so that
+ * reopening a large file does not have to wrap it again up to the bookmark.
+ *
+ * record: header, file name, file size, modification time, layout key,
+ *         last_page, max_page, (last_page + 1) page positions
+ */
+#define TV_INDEX_FILE         VIEWERS_DATA_DIR "/tv_pages.dat"
+#define TV_INDEX_HEADER       "TVP\x02"
+#define TV_INDEX_HEADER_SIZE  4
+#define TV_INDEX_RECORD_SIZE  (TV_INDEX_HEADER_SIZE + MAX_PATH + 20)
+
+static int stored_last_page;
+static unsigned int file_mtime;
+
 static struct tv_screen_pos cur_pos;
 
 static int parse_page;
@@ -73,6 +88,136 @@ static off_t tv_get_fpos(int page)
     return 0;
 }
 
+/* checksum of the preferences that change where the pages break */
+static unsigned int tv_get_layout_key(void)
+{
+    unsigned char buf[12];
+    unsigned int key;
+
+    buf[0]  = preferences->word_mode;
+    buf[1]  = preferences->line_mode;
+    buf[2]  = preferences->windows;
+    buf[3]  = preferences->encoding;
+    buf[4]  = preferences->indent_spaces;
+    buf[5]  = preferences->horizontal_scrollbar;
+    buf[6]  = preferences->vertical_scrollbar;
+    buf[7]  = preferences->header_mode;
+    buf[8]  = preferences->footer_mode;
+    buf[9]  = preferences->statusbar;
+    buf[10] = LCD_WIDTH  & 0xff;
+    buf[11] = LCD_HEIGHT & 0xff;
+
+    key = rb->crc_32(buf, sizeof(buf), 0xffffffff);
+    return rb->crc_32(preferences->font_name,
+                      rb->strlen(preferences->font_name), key);
+}
+
+/* modification time of the file, so that an edit which keeps the size
+ * doesn't reuse the index. 0 if it can't be found */
+static unsigned int tv_get_file_mtime(const char *file_name)
+{
+    char dirname[MAX_PATH];
+    const char *basename = rb->strrchr(file_name, '/');
+    struct dirent *entry;
+    unsigned int mtime = 0;
+    DIR *dir;
+
+    if (!basename || basename - file_name >= MAX_PATH)
+        return 0;
+
+    rb->strlcpy(dirname, file_name, basename - file_name + 1);
+    dir = rb->opendir(dirname[0] ? dirname : "/");
+    if (!dir)
+        return 0;
+
+    basename++;
+    while ((entry = rb->readdir(dir)) != NULL)
+    {
+        if (!rb->strcmp(entry->d_name, basename))
+        {
+            mtime = rb->dir_get_info(dir, entry).mtime;
+            break;
+        }
+    }
+    rb->closedir(dir);
+    return mtime;
+}
+
+static void tv_load_page_index(void)
+{
+    unsigned char buf[TV_INDEX_RECORD_SIZE];
+    unsigned char *p = buf + TV_INDEX_HEADER_SIZE + MAX_PATH;
+    int index_last_page;
+    int index_max_page;
+    int fd;
+
+    stored_last_page = 0;
+    file_mtime = tv_get_file_mtime((const char *)preferences->file_name);
+
+    fd = rb->open(TV_INDEX_FILE, O_RDONLY);
+    if (fd < 0)
+        return;
+
+    if (rb->read(fd, buf, TV_INDEX_RECORD_SIZE) == TV_INDEX_RECORD_SIZE &&
+        rb->memcmp(buf, TV_INDEX_HEADER, TV_INDEX_HEADER_SIZE) == 0 &&
+        rb->strcmp(buf + TV_INDEX_HEADER_SIZE, preferences->file_name) == 0 &&
+        get_uint32(p) == (unsigned int)tv_get_file_size() &&
+        get_uint32(p + 4) == file_mtime &&
+        get_uint32(p + 8) == tv_get_layout_key())
+    {
+        index_last_page = get_uint32(p + 12);
+        index_max_page  = get_uint32(p + 16);
+
+        if (index_last_page > 0 && index_last_page <= index_max_page &&
+            index_max_page < TV_MAX_PAGE &&
+            rb->read(fd, pager_buffer, (index_last_page + 1) * 4) ==
+                                       (index_last_page + 1) * 4)
+        {
+            last_page = index_last_page;
+            max_page  = index_max_page;
+            stored_last_page = last_page;
+        }
+        else
+            tv_set_fpos(0, 0);
+    }
+    rb->close(fd);
+}
+
+static void tv_save_page_index(void)
+{
+    unsigned char buf[TV_INDEX_RECORD_SIZE];
+    unsigned char *p = buf + TV_INDEX_HEADER_SIZE + MAX_PATH;
+    int size = (last_page + 1) * 4;
+    int fd;
+
+    /* nothing new was paginated in this session */
+    if (last_page <= stored_last_page)
+        return;
+
+    fd = rb->open(TV_INDEX_FILE, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+    if (fd < 0)
+        return;
+
+    rb->memset(buf, 0, TV_INDEX_RECORD_SIZE);
+    rb->memcpy(buf, TV_INDEX_HEADER, TV_INDEX_HEADER_SIZE);
+    rb->strlcpy(buf + TV_INDEX_HEADER_SIZE, preferences->file_name, MAX_PATH);
+    set_uint32(p,      tv_get_file_size());
+    set_uint32(p + 4,  file_mtime);
+    set_uint32(p + 8,  tv_get_layout_key());
+    set_uint32(p + 12, last_page);
+    set_uint32(p + 16, max_page);
+
+    if (rb->write(fd, buf, TV_INDEX_RECORD_SIZE) != TV_INDEX_RECORD_SIZE ||
+        rb->write(fd, pager_buffer, size) != size)
+    {
+        rb->close(fd);
+        rb->remove(TV_INDEX_FILE);
+        return;
+    }
+    rb->close(fd);
+    stored_last_page = last_page;
+}
+
 static int tv_change_preferences(const struct tv_preferences *oldp)
 {
     (void)oldp;
@@ -82,6 +227,7 @@ static int tv_change_preferences(const struct tv_preferences *oldp)
     last_page = 0;
     max_page  = TV_MAX_PAGE - 1;
     tv_set_fpos(cur_pos.page, 0);
+    tv_load_page_index();
     tv_seek(0, SEEK_SET);
     return TV_CALLBACK_OK;
 }
@@ -101,6 +247,7 @@ bool tv_init_pager(unsigned char **buf, size_t *size)
 
 void tv_finalize_pager(void)
 {
+    tv_save_page_index();
     tv_finalize_reader();
 }
 
@@ -202,12 +349,19 @@ static bool tv_create_line_positions(void)
 void tv_convert_fpos(off_t fpos, struct tv_screen_pos *pos)
 {
     int i;
+    int low = 0;
+    int high = last_page;
 
-    for (i = 0; i < last_page; i++)
+    /* the page positions are ascending, find the last page before fpos */
+    while (low < high)
     {
-        if (tv_get_fpos(i) <= fpos && tv_get_fpos(i + 1) > fpos)
-            break;
+        i = (low + high + 1) / 2;
+        if (tv_get_fpos(i) <= fpos)
+            low = i;
+        else
+            high = i - 1;
     }
+    i = low;
 
     pos->page     = i;
     pos->line     = 0;
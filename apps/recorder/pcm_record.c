@@ -259,6 +259,15 @@ static size_t         flood_watermark;  /* Max limit for thread prio boost */
 static bool           prio_boosted;
 #endif
 
+/** Pipeline statistics, see struct pcm_rec_stats **/
+static volatile size_t   pcm_buf_peak;
+static volatile unsigned pcm_overflows;
+static size_t         enc_buf_peak;     /* In slots                        */
+static unsigned       enc_stalls;
+static bool           enc_waiting;      /* Last request found no space     */
+static unsigned       enc_overflows;
+static long           write_peak_ticks;
+
 /** Stream marking **/
 enum mark_stream_action
 {
@@ -490,11 +499,21 @@ static void pcm_rec_have_more(void **start, size_t *size)
 
     if (!pcm_pause)
     {
+        size_t used = pcmbuf_used();
+
         /* One empty chunk must remain after widx is advanced */
-        if (pcmbuf_used() <= PCM_BUF_SIZE - 2*PCM_CHUNK_SIZE)
+        if (used <= PCM_BUF_SIZE - 2*PCM_CHUNK_SIZE)
+        {
             next_idx = pcmbuf_add(next_idx, PCM_CHUNK_SIZE);
+            used += PCM_CHUNK_SIZE;
+            if (used > pcm_buf_peak)
+                pcm_buf_peak = used;
+        }
         else
+        {
             set_warning_bits(PCMREC_W_PCM_BUFFER_OVF);
+            pcm_overflows++;
+        }
     }
 
     *start = pcmbuf_ptr(next_idx);
@@ -577,6 +596,14 @@ static void reset_fifos(bool hard)
 
     /* No overflow-related warnings now */
     clear_warning_status(PCMREC_W_PCM_BUFFER_OVF | PCMREC_W_ENC_BUFFER_OVF);
+
+    pcm_buf_peak = 0;
+    pcm_overflows = 0;
+    enc_buf_peak = 0;
+    enc_stalls = 0;
+    enc_waiting = false;
+    enc_overflows = 0;
+    write_peak_ticks = 0;
 }
 
 /* Initialize file statistics */
@@ -814,8 +841,13 @@ static bool stream_flush_buf(void)
     if (stream_buf_used == 0)
         return true;
 
+    long tick = current_tick;
     ssize_t rc = write(rec_fd, stream_buffer, stream_buf_used);
 
+    tick = current_tick - tick;
+    if (tick > write_peak_ticks)
+        write_peak_ticks = tick;
+
     if (LIKELY(rc == stream_buf_used))
     {
         stream_discard_buf();
@@ -948,6 +980,21 @@ unsigned long pcm_rec_sample_rate(void)
 }
 #endif
 
+/* Return the pipeline statistics collected since the last reset */
+void pcm_rec_get_stats(struct pcm_rec_stats *stats)
+{
+    stats->pcm_buf_size     = PCM_BUF_SIZE;
+    stats->pcm_buf_used     = pcmbuf_used();
+    stats->pcm_buf_peak     = pcm_buf_peak;
+    stats->pcm_overflows    = pcm_overflows;
+    stats->enc_buf_size     = enc_buflen*ENC_HDR_SIZE;
+    stats->enc_buf_peak     = enc_buf_peak*ENC_HDR_SIZE;
+    stats->enc_stalls       = enc_stalls;
+    stats->enc_overflows    = enc_overflows;
+    stats->write_peak_ticks = write_peak_ticks;
+    stats->sample_rate      = sample_rate;
+}
+
 
 /** audio_* group **/
 
@@ -1904,6 +1951,9 @@ static struct enc_chunk_data * enc_encbuf_get_buffer(size_t need)
         {
             /* Empty but request larger than any possible space */
             raise_warning_status(PCMREC_W_ENC_BUFFER_OVF);
+            enc_overflows++;
+            sleep(0);
+            return NULL;
         }
         else if (state != REC_STATE_FLUSH && encbuf_used() < high_watermark)
         {
@@ -1911,10 +1961,19 @@ static struct enc_chunk_data * enc_encbuf_get_buffer(size_t need)
             encbuf_request_flush();
         }
 
+        /* The encoder polls until there is space, count each wait once */
+        if (!enc_waiting)
+        {
+            enc_waiting = true;
+            enc_stalls++;
+        }
+
         sleep(0);
         return NULL;
     }
 
+    enc_waiting = false;
+
     struct enc_chunk_data *data =
         encbuf_get_write_ptr(enc_widx, need, &enc_widx);
 
@@ -1948,6 +2007,7 @@ static void enc_encbuf_finish_buffer(void)
     {
         /* Claims it wrote too much? */
         raise_warning_status(PCMREC_W_ENC_BUFFER_OVF);
+        enc_overflows++;
         return;
     }
 
@@ -1961,6 +2021,10 @@ static void enc_encbuf_finish_buffer(void)
 
     encbuf_widx_advance(enc_widx, count);
 
+    size_t used = encbuf_used();
+    if (used > enc_buf_peak)
+        enc_buf_peak = used;
+
     encbuf_rec_count += count;
     num_rec_bytes += data_size;
     num_rec_samples += data->pcm_count;
@@ -78,6 +78,24 @@ unsigned long pcm_rec_sample_rate(void);
 
 void recording_init(void);
 
+/* Statistics on how well the capture -> encode -> write pipeline keeps up,
+ * collected since recording was last initialized or reset */
+struct pcm_rec_stats
+{
+    size_t   pcm_buf_size;      /* Size of the PCM buffer in bytes         */
+    size_t   pcm_buf_used;      /* Current PCM buffer fill in bytes        */
+    size_t   pcm_buf_peak;      /* Highest PCM buffer fill in bytes        */
+    unsigned pcm_overflows;     /* Number of PCM chunks dropped            */
+    size_t   enc_buf_size;      /* Size of the encoder buffer in bytes     */
+    size_t   enc_buf_peak;      /* Highest encoder buffer fill in bytes    */
+    unsigned enc_stalls;        /* Times the encoder waited for free space */
+    unsigned enc_overflows;     /* Number of encoded chunks dropped        */
+    long     write_peak_ticks;  /* Longest single write to disk in ticks   */
+    unsigned long sample_rate;  /* To convert buffer fill into latency     */
+};
+
+void pcm_rec_get_stats(struct pcm_rec_stats *stats);
+
 /* audio.h contains audio_* recording functions */
 
 #endif /* PCM_RECORD_H */
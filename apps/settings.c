@@ -183,6 +183,9 @@ static bool settings_crc_changed(void)
     return false;
 }
 
+static bool settings_load_snapshot(const char *file);
+static void settings_write_snapshot(const char *file);
+
 /** Reading from a config file **/
 /*
  * load settings from disk
@@ -196,7 +199,13 @@ void settings_load(void)
     rename_temp_file(RESUMEFILE_TEMP, RESUMEFILE, RESUMEFILE".old");
     rename_temp_file(CONFIGFILE_TEMP, CONFIGFILE, CONFIGFILE".old");
 
-    settings_load_config(CONFIGFILE, false); /* load user_settings items */
+    /* load user_settings items, from the binary snapshot if it is current */
+    if (!settings_load_snapshot(CONFIGFILE) &&
+        settings_load_config(CONFIGFILE, false))
+    {
+        settings_write_snapshot(CONFIGFILE);
+    }
+
     settings_load_config(RESUMEFILE, false); /* load system_status items */
 
     /* fixed settings file has final say on user_settings AND system_status items */
@@ -627,6 +636,253 @@ static bool settings_write_config(const char* filename, int options)
     return true;
 }
 
+/** Binary snapshot of the parsed config file **/
+
+/* Parsing config.cfg line by line is a noticeable part of booting. Once it
+ * has been parsed, the resulting global_settings and global_status are
+ * stored in CONFIGSNAPSHOT along with the size and CRC of the text they came
+ * from. As long as the firmware and config.cfg stay the same, later boots
+ * read that back instead. config.cfg remains the authoritative copy, any
+ * change to it (by us or by the user) invalidates the snapshot.
+ *
+ * Parsing does more than set the variables: custom settings are loaded by
+ * their own functions, which may keep pointers, and bool settings may have
+ * callbacks. So the snapshot also lists the settings the file sets, in file
+ * order, with the text of the custom ones, and loading it replays those. */
+#define SNAPSHOT_MAGIC      0x52425353 /* 'RBSS' */
+#define SNAPSHOT_VERSION    2
+
+struct settings_snapshot_header
+{
+    uint32_t magic;
+    uint32_t layout;    /* identifies build and struct layout */
+    uint32_t cfg_size;  /* size of the config file it was parsed from */
+    uint32_t cfg_crc;   /* crc of the config file it was parsed from */
+    uint32_t data_crc;  /* crc of everything after the header */
+};
+
+/* follows global_settings and global_status, one per config file line */
+struct settings_snapshot_line
+{
+    uint16_t index;     /* into settings[] */
+    uint16_t len;       /* of the value text which follows, including the
+                           terminator. only custom settings keep it */
+};
+
+static uint32_t snapshot_layout(void)
+{
+    uint32_t layout[] = {
+        SNAPSHOT_VERSION, sizeof(global_settings), sizeof(global_status),
+        nb_settings,
+    };
+    uint32_t crc = crc_32(layout, sizeof(layout), 0xFFFFFFFF);
+
+    /* the lines refer to settings by index */
+    for (int i = 0; i < nb_settings; i++)
+    {
+        if (settings[i].cfg_name)
+            crc = crc_32(settings[i].cfg_name, strlen(settings[i].cfg_name),
+                         crc);
+        crc = crc_32(&settings[i].flags, sizeof(settings[i].flags), crc);
+    }
+    return crc_32(rbversion, strlen(rbversion), crc);
+}
+
+static uint32_t snapshot_data_crc(void)
+{
+    return crc_32(&global_status, sizeof(global_status),
+                  crc_32(&global_settings, sizeof(global_settings), 0xFFFFFFFF));
+}
+
+static bool config_file_crc(const char *file, uint32_t *size, uint32_t *crc)
+{
+    char buf[256];
+    ssize_t len;
+    int fd = open(file, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    *size = 0;
+    *crc = 0xFFFFFFFF;
+    while ((len = read(fd, buf, sizeof(buf))) > 0)
+    {
+        *crc = crc_32(buf, len, *crc);
+        *size += len;
+    }
+    close(fd);
+    return len == 0;
+}
+
+/* read the next line record, false at the end or on error */
+static bool snapshot_read_line(int fd, struct settings_snapshot_line *line,
+                               char *value, size_t size, uint32_t *crc)
+{
+    if (read(fd, line, sizeof(*line)) != sizeof(*line))
+        return false;
+    if (line->index >= nb_settings || line->len > size ||
+        read(fd, value, line->len) != line->len)
+    {
+        *crc = ~*crc; /* make sure it doesn't match */
+        return false;
+    }
+
+    *crc = crc_32(line, sizeof(*line), *crc);
+    *crc = crc_32(value, line->len, *crc);
+    if (line->len > 0)
+        value[line->len - 1] = '\0';
+    return true;
+}
+
+/* returns true if global_settings and global_status were loaded */
+static bool settings_load_snapshot(const char *file)
+{
+    struct settings_snapshot_header hdr;
+    struct settings_snapshot_line line;
+    uint32_t cfg_size, cfg_crc, crc;
+    off_t lines_pos;
+    char value[MAX_PATH];
+
+    int fd = open(CONFIGSNAPSHOT, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    bool valid = read(fd, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+                 hdr.magic == SNAPSHOT_MAGIC &&
+                 hdr.layout == snapshot_layout() &&
+                 config_file_crc(file, &cfg_size, &cfg_crc) &&
+                 hdr.cfg_size == cfg_size && hdr.cfg_crc == cfg_crc;
+
+    if (valid)
+    {
+        valid = read(fd, &global_settings, sizeof(global_settings))
+                    == sizeof(global_settings) &&
+                read(fd, &global_status, sizeof(global_status))
+                    == sizeof(global_status);
+
+        /* check the lines before replaying any of them */
+        lines_pos = lseek(fd, 0, SEEK_CUR);
+        crc = snapshot_data_crc();
+        while (valid && snapshot_read_line(fd, &line, value, sizeof(value), &crc))
+            ;
+        valid = valid && crc == hdr.data_crc &&
+                lseek(fd, lines_pos, SEEK_SET) == lines_pos;
+
+        if (!valid) /* partially overwritten, start over from the text */
+        {
+            logf("%s: corrupt", __func__);
+            settings_reset();
+        }
+    }
+
+    if (!valid)
+    {
+        close(fd);
+        return false;
+    }
+
+    /* custom settings start over from their defaults like they do before
+       parsing, the snapshot has their variables from an earlier boot */
+    for (int i = 0; i < nb_settings; i++)
+    {
+        if ((settings[i].flags & F_T_MASK) == F_T_CUSTOM)
+            reset_setting(&settings[i], settings[i].setting);
+    }
+
+    /* redo what parsing does besides setting the variables */
+    crc = 0;
+    while (snapshot_read_line(fd, &line, value, sizeof(value), &crc))
+    {
+        const struct settings_list *setting = &settings[line.index];
+
+        if ((setting->flags & F_T_MASK) == F_T_CUSTOM)
+        {
+            setting->custom_setting->load_from_cfg(setting->setting, value);
+        }
+        else if ((setting->flags & F_BOOL_SETTING) == F_BOOL_SETTING &&
+                 setting->bool_setting->option_callback)
+        {
+            setting->bool_setting->option_callback(*(bool*)setting->setting);
+        }
+    }
+    close(fd);
+
+    logf("%s: loaded", __func__);
+    return true;
+}
+
+/* write a line record for every setting the config file sets */
+static bool snapshot_write_lines(int fd, const char *file, uint32_t *crc)
+{
+    char text[128];
+    char *name, *value;
+    bool ok = true;
+
+    int cfg = open_utf8(file, O_RDONLY);
+    if (cfg < 0)
+        return false;
+
+    while (ok && read_line(cfg, text, sizeof text) > 0)
+    {
+        if (!settings_parseline(text, &name, &value))
+            continue;
+
+        const struct settings_list *setting = find_setting_by_cfgname(name);
+        if (!setting)
+            continue;
+
+        struct settings_snapshot_line line = {
+            .index = setting - settings,
+            .len = 0,
+        };
+        if ((setting->flags & F_T_MASK) == F_T_CUSTOM)
+            line.len = strlen(value) + 1;
+
+        *crc = crc_32(&line, sizeof(line), *crc);
+        *crc = crc_32(value, line.len, *crc);
+        ok = write(fd, &line, sizeof(line)) == sizeof(line) &&
+             write(fd, value, line.len) == line.len;
+    }
+    close(cfg);
+    return ok;
+}
+
+static void settings_write_snapshot(const char *file)
+{
+    struct settings_snapshot_header hdr;
+
+    if (!config_file_crc(file, &hdr.cfg_size, &hdr.cfg_crc))
+    {
+        remove(CONFIGSNAPSHOT);
+        return;
+    }
+
+    hdr.magic = SNAPSHOT_MAGIC;
+    hdr.layout = snapshot_layout();
+    hdr.data_crc = snapshot_data_crc();
+
+    /* write to a temp file and rename, so a snapshot is either complete
+       or not there at all. the header is written again at the end, once
+       the crc of the lines is known */
+    int fd = open(CONFIGSNAPSHOT ".new", O_CREAT|O_TRUNC|O_WRONLY, 0666);
+    if (fd < 0)
+        return;
+
+    bool ok = write(fd, &hdr, sizeof(hdr)) == sizeof(hdr) &&
+              write(fd, &global_settings, sizeof(global_settings))
+                  == sizeof(global_settings) &&
+              write(fd, &global_status, sizeof(global_status))
+                  == sizeof(global_status) &&
+              snapshot_write_lines(fd, file, &hdr.data_crc) &&
+              lseek(fd, 0, SEEK_SET) == 0 &&
+              write(fd, &hdr, sizeof(hdr)) == sizeof(hdr);
+    close(fd);
+
+    if (ok)
+        rename(CONFIGSNAPSHOT ".new", CONFIGSNAPSHOT);
+    else
+        remove(CONFIGSNAPSHOT ".new");
+}
+
 static void flush_global_status_callback(void)
 {
     if (TIME_AFTER(current_tick, next_status_update_tick))
@@ -1158,13 +1414,79 @@ void settings_reset(void)
         }
     }
 }
+#endif /* __PCTOOL__ */
 
-/** Changing setting values **/
-const struct settings_list* find_setting(const void* variable)
+/** Looking up settings **/
+
+/* Both lookups used to walk the whole settings[] table, which made loading
+ * a .cfg O(lines * settings). Index tables are built once instead. */
+static bool settings_index_built = false;
+
+static unsigned int cfgname_hash(const char *name)
+{
+    unsigned int hash = 5381;
+    while (*name)
+        hash = hash * 33 + tolower((unsigned char)*name++);
+    return hash % (2 * nb_settings);
+}
+
+static int compare_by_address(const void *p1, const void *p2)
+{
+    const struct settings_list *s1 = &settings[*(const uint16_t *)p1];
+    const struct settings_list *s2 = &settings[*(const uint16_t *)p2];
+
+    if (s1->setting != s2->setting)
+        return (uintptr_t)s1->setting < (uintptr_t)s2->setting ? -1 : 1;
+    /* keep table order for shared variables */
+    return (s1 < s2) ? -1 : 1;
+}
+
+static void settings_index_init(void)
 {
+    memset(settings_by_cfgname, 0, 2 * nb_settings * sizeof(uint16_t));
+
     for(int i = 0; i < nb_settings; i++)
     {
-        const struct settings_list *setting = &settings[i];
+        settings_by_address[i] = i;
+
+        const char *name = settings[i].cfg_name;
+        if (!name)
+            continue;
+
+        /* linear probing, table order is kept for duplicate names */
+        unsigned int slot = cfgname_hash(name);
+        while (settings_by_cfgname[slot] != 0)
+            slot = (slot + 1) % (2 * nb_settings);
+        settings_by_cfgname[slot] = i + 1;
+    }
+
+    qsort(settings_by_address, nb_settings, sizeof(uint16_t),
+          compare_by_address);
+
+    settings_index_built = true;
+}
+
+#ifndef __PCTOOL__
+const struct settings_list* find_setting(const void* variable)
+{
+    if (!settings_index_built)
+        settings_index_init();
+
+    /* find the first entry using this variable */
+    int low = 0, high = nb_settings;
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+        if ((uintptr_t)settings[settings_by_address[mid]].setting <
+            (uintptr_t)variable)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low < nb_settings)
+    {
+        const struct settings_list *setting = &settings[settings_by_address[low]];
         if (setting->setting == variable)
             return setting;
     }
@@ -1176,13 +1498,19 @@ const struct settings_list* find_setting(const void* variable)
 const struct settings_list* find_setting_by_cfgname(const char* name)
 {
     logf("Searching for Setting: '%s'",name);
-    for(int i = 0; i < nb_settings; i++)
+
+    if (!settings_index_built)
+        settings_index_init();
+
+    unsigned int slot = cfgname_hash(name);
+    for (int i; (i = settings_by_cfgname[slot]) != 0;
+         slot = (slot + 1) % (2 * nb_settings))
     {
-        const struct settings_list *setting = &settings[i];
-        if (setting->cfg_name && !strcasecmp(setting->cfg_name, name))
+        const struct settings_list *setting = &settings[i - 1];
+        if (!strcasecmp(setting->cfg_name, name))
         {
 #ifdef LOGF_ENABLE
-            name = debug_get_flags(settings[i].flags);
+            name = debug_get_flags(setting->flags);
             logf("Found, %s", name);
 #endif
             return setting;
@@ -1676,6 +1676,9 @@ const struct settings_list settings[] = {
     {F_T_INT|F_RECSETTING|F_HAS_CFGVALS, &global_settings.mp3_enc_config.bitrate,-1,
         INT(MP3_ENC_BITRATE_CFG_DEFAULT),
         "mp3_enc bitrate",{.cfg_vals=MP3_ENC_BITRATE_CFG_VALUE_LIST}},
+    {F_T_INT|F_RECSETTING|F_HAS_CFGVALS, &global_settings.mp3_enc_config.speed,-1,
+        INT(MP3_ENC_SPEED_CFG_DEFAULT),
+        "mp3_enc speed",{.cfg_vals=MP3_ENC_SPEED_CFG_VALUE_LIST}},
     /* wav_enc */
     /* (no settings yet) */
     /* wavpack_enc */
@@ -2444,6 +2447,11 @@ OFFON_SETTING(0, subharmonic_pregain,
 
 const int nb_settings = sizeof(settings)/sizeof(*settings);
 
+/* lookup tables for find_setting() and find_setting_by_cfgname(), built on
+ * first use by settings.c */
+uint16_t settings_by_cfgname[2 * sizeof(settings)/sizeof(*settings)];
+uint16_t settings_by_address[sizeof(settings)/sizeof(*settings)];
+
 const struct settings_list* get_settings_list(int*count)
 {
     *count = nb_settings;
@@ -192,6 +192,10 @@ const struct settings_list* get_settings_list(int*count);
    possibly fix proberly later */
 extern const struct settings_list  settings[];
 extern const int nb_settings;
+/* open addressing hash table of settings[] index + 1, 2 * nb_settings slots */
+extern uint16_t settings_by_cfgname[];
+/* settings[] indices, sorted by the address of their variable */
+extern uint16_t settings_by_address[];
 
 #endif
 
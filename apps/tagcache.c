@@ -3562,40 +3562,30 @@ void tagcache_commit_finalize(void)
 #if !defined(PLUGIN)
 #ifndef __PCTOOL__
 
-static bool modify_numeric_entry(int masterfd, int idx_id, int tag, long data)
+/* Apply a run of numeric updates that all belong to the same index entry,
+ * reading and writing the entry only once. Later updates of a tag win. */
+static bool modify_numeric_entry(int masterfd,
+                                 const struct tagcache_command_entry *ce,
+                                 int count)
 {
     struct index_entry idx;
 
     if (!tc_stat.ready)
         return false;
 
-    if (!TAGCACHE_IS_NUMERIC(tag))
+    if (!get_index(masterfd, ce->idx_id, &idx, false))
         return false;
 
-    if (!get_index(masterfd, idx_id, &idx, false))
-        return false;
-
-    idx.tag_seek[tag] = data;
-    idx.flag |= FLAG_DIRTYNUM;
-
-    return write_index(masterfd, idx_id, &idx);
-}
-
-#if 0
-bool tagcache_modify_numeric_entry(struct tagcache_search *tcs,
-                                   int tag, long data)
-{
-    struct master_header myhdr;
-
-    if (tcs->masterfd < 0)
+    for (int i = 0; i < count; i++)
     {
-        if ( (tcs->masterfd = open_master_fd(&myhdr, true)) < 0)
-            return false;
+        if (TAGCACHE_IS_NUMERIC(ce[i].tag))
+            idx.tag_seek[ce[i].tag] = ce[i].data;
     }
 
-    return modify_numeric_entry(tcs->masterfd, tcs->idx_id, tag, data);
+    idx.flag |= FLAG_DIRTYNUM;
+
+    return write_index(masterfd, ce->idx_id, &idx);
 }
-#endif
 
 static bool command_queue_is_full(void)
 {
@@ -3610,13 +3600,21 @@ static bool command_queue_is_full(void)
 
 static void command_queue_sync_callback(void)
 {
+    /* numeric updates, sorted by index entry. Not on the stack, this may
+       run on the storage thread; the queue mutex protects it. */
+    static struct tagcache_command_entry numeric[TAGCACHE_COMMAND_QUEUE_LENGTH];
+    int count = 0;
+    bool update_header = false;
     struct master_header myhdr;
     int masterfd;
 
     mutex_lock(&command_queue_mutex);
 
     if ( (masterfd = open_master_fd(&myhdr, true)) < 0)
+    {
+        mutex_unlock(&command_queue_mutex);
         return;
+    }
 
     while (command_queue_ridx != command_queue_widx)
     {
@@ -3626,18 +3624,18 @@ static void command_queue_sync_callback(void)
         {
             case CMD_UPDATE_MASTER_HEADER:
             {
-                close(masterfd);
-                update_master_header();
-
-                /* Re-open the masterfd. */
-                if ( (masterfd = open_master_fd(&myhdr, true)) < 0)
-                    return;
-
+                /* only the latest header matters, write it once at the end */
+                update_header = true;
                 break;
             }
             case CMD_UPDATE_NUMERIC:
             {
-                modify_numeric_entry(masterfd, ce->idx_id, ce->tag, ce->data);
+                /* stable insertion sort, so the master file is written in
+                   one forward pass and the order of updates is kept */
+                int i = count++;
+                for (; i > 0 && numeric[i-1].idx_id > ce->idx_id; i--)
+                    numeric[i] = numeric[i-1];
+                numeric[i] = *ce;
                 break;
             }
         }
@@ -3646,8 +3644,19 @@ static void command_queue_sync_callback(void)
             command_queue_ridx = 0;
     }
 
+    for (int i = 0, run; i < count; i += run)
+    {
+        for (run = 1; i + run < count
+                      && numeric[i + run].idx_id == numeric[i].idx_id; run++);
+
+        modify_numeric_entry(masterfd, &numeric[i], run);
+    }
+
     close(masterfd);
 
+    if (update_header)
+        update_master_header();
+
     tc_stat.queue_length = 0;
     mutex_unlock(&command_queue_mutex);
 }
@@ -3674,6 +3683,28 @@ static void queue_command(int cmd, long idx_id, int tag, long data)
         if (next >= TAGCACHE_COMMAND_QUEUE_LENGTH)
             next = 0;
 
+        /* A pending update of the same tag is simply replaced, so repeated
+           changes only take a single slot. */
+        if (cmd == CMD_UPDATE_NUMERIC)
+        {
+            int ridx = command_queue_widx;
+
+            while (ridx != command_queue_ridx)
+            {
+                if (--ridx < 0)
+                    ridx = TAGCACHE_COMMAND_QUEUE_LENGTH - 1;
+
+                struct tagcache_command_entry *ce = &command_queue[ridx];
+                if (ce->command == CMD_UPDATE_NUMERIC
+                    && ce->idx_id == idx_id && ce->tag == tag)
+                {
+                    ce->data = data;
+                    mutex_unlock(&command_queue_mutex);
+                    return;
+                }
+            }
+        }
+
         /* Make sure queue is not full. */
         if (next != command_queue_ridx)
         {
@@ -930,6 +930,39 @@ static int compare_with_albums(const void *p1, const void *p2)
     return qsort_fn(e1->name, e2->name, MAX_PATH);
 }
 
+static bool sort_keys_inverse;
+
+static int compare_keys(const void *p1, const void *p2)
+{
+    const struct tagentry *e1 = (const struct tagentry *)p1;
+    const struct tagentry *e2 = (const struct tagentry *)p2;
+    int res = strcmp(natsort_key(e1), natsort_key(e2));
+    if (res != 0)
+        return sort_keys_inverse ? -res : res;
+    return qsort_fn(e1->name, e2->name, MAX_PATH);
+}
+
+static const char *tagentry_name(const void *entry)
+{
+    return ((const struct tagentry *)entry)->name;
+}
+
+/* sort by natural sort keys when numbers are interpreted, if they fit */
+static void sort_entries(struct tagentry *entries, int count,
+                         bool by_albums, bool inverse)
+{
+    if (count > 1 && !by_albums && global_settings.interpret_numbers)
+    {
+        sort_keys_inverse = inverse;
+        if (natsort_by_keys(entries, count, sizeof(struct tagentry),
+                            tagentry_name, true, compare_keys))
+            return;
+    }
+
+    qsort(entries, count, sizeof(struct tagentry),
+          by_albums ? compare_with_albums : compare);
+}
+
 static void tagtree_buffer_event(unsigned short id, void *ev_data)
 {
     (void)id;
@@ -1916,11 +1949,10 @@ entry_skip_formatter:
             qsort_fn = sort_inverse ? strncasecmp_inv : strncasecmp;
 
         struct tagentry *entries = get_entries(c);
-        qsort(&entries[c->special_entry_count],
-              current_entry_count - c->special_entry_count,
-              sizeof(struct tagentry),
-              c->currtable == TABLE_ALLSUBENTRIES_SORTED_BY_ALBUMS ? compare_with_albums : compare
-        );
+        sort_entries(&entries[c->special_entry_count],
+                     current_entry_count - c->special_entry_count,
+                     c->currtable == TABLE_ALLSUBENTRIES_SORTED_BY_ALBUMS,
+                     sort_inverse);
     }
 
     if (!init)
@@ -2105,6 +2137,7 @@ int tagtree_load(struct tree_context* c)
 
     /* The _total_ numer of entries available. */
     c->dirlength = c->filesindir = count;
+    c->firstpos = 0;
 
     return count;
 }
@@ -140,11 +140,19 @@ static struct buflib_context clip_ctx;
 struct clip_cache_metadata {
     long tick;
     int handle, voice_id;
+    bool prefetched; /* loaded ahead of time and not played yet */
 };
 
 static int metadata_table_handle;
 static unsigned max_clips;
 static int cache_hits, cache_misses;
+static int prefetches, prefetch_hits;
+
+/* IDs noted by talk_id() between talk_prefetch_begin() and _end() */
+#define PREFETCH_SIZE 8
+static int32_t prefetch_ids[PREFETCH_SIZE];
+static int prefetch_count, prefetch_next;
+static bool prefetch_collect;
 
 static struct queue_entry queue[QUEUE_SIZE]; /* queue of scheduled clips */
 static struct queue_entry silence, *last_clip;
@@ -355,7 +363,8 @@ static int free_oldest_clip(void)
 }
 
 /* common code for load_initial_clips() and get_clip() */
-static void add_cache_entry(int clip_handle, int table_index, int id)
+static struct clip_cache_metadata *add_cache_entry(int clip_handle,
+                                                   int table_index, int id)
 {
     unsigned i;
     struct clip_cache_metadata *cc = buflib_get_data(&clip_ctx, metadata_table_handle);
@@ -376,6 +385,8 @@ static void add_cache_entry(int clip_handle, int table_index, int id)
     cc->handle = clip_handle;
     cc->tick = current_tick;
     cc->voice_id = id;
+    cc->prefetched = false;
+    return cc;
 }
 
 static ssize_t read_clip_data(int fd, int index, int clip_handle)
@@ -439,6 +450,27 @@ static void load_initial_clips(int fd)
 #endif
 }
 
+/* load a clip from the voice file into the cache,
+ * returns its cache entry or NULL on error */
+static struct clip_cache_metadata *load_clip(long id, int index,
+                                             size_t clipsize)
+{
+    int fd, handle, oldest = -1;
+    ssize_t ret;
+    /* free clips from cache until this one succeeds to allocate */
+    while ((handle = buflib_alloc(&clip_ctx, clipsize)) < 0)
+        oldest = free_oldest_clip();
+    /* handle should now hold a valid alloc. Load from disk
+     * and insert into cache */
+    fd = open_voicefile();
+    ret = read_clip_data(fd, index, handle);
+    close(fd);
+    if (ret < 0)
+        return NULL;
+    /* finally insert into metadata table */
+    return add_cache_entry(handle, oldest, id);
+}
+
 /* fetch a clip from the voice file */
 static int get_clip(long id, struct queue_entry *q)
 {
@@ -458,22 +490,12 @@ static int get_clip(long id, struct queue_entry *q)
 
     if (!(clipsize & LOADED_MASK))
     {   /* clip needs loading */
-        int fd, handle, oldest = -1;
-        ssize_t ret;
+        struct clip_cache_metadata *cc;
         cache_misses++;
-        /* free clips from cache until this one succeeds to allocate */
-        while ((handle = buflib_alloc(&clip_ctx, clipsize)) < 0)
-            oldest = free_oldest_clip();
-        /* handle should now hold a valid alloc. Load from disk
-         * and insert into cache */
-        fd = open_voicefile();
-        ret = read_clip_data(fd, index, handle);
-        close(fd);
-        if (ret < 0)
-            return ret;
-        /* finally insert into metadata table */
-        add_cache_entry(handle, oldest, id);
-        retval = handle;
+        cc = load_clip(id, index, clipsize);
+        if (!cc)
+            return -2;
+        retval = cc->handle;
     }
     else
     {   /* clip is in memory already; find where it was loaded */
@@ -483,6 +505,11 @@ static int get_clip(long id, struct queue_entry *q)
         cc = buflib_get_data(&clip_ctx, metadata_table_handle);
         for (i = 0; cc[i].voice_id != id || !cc[i].handle; i++) ;
         cc[i].tick = current_tick; /* reset age */
+        if (cc[i].prefetched)
+        {
+            prefetch_hits++;
+            cc[i].prefetched = false;
+        }
         clipsize &= ~LOADED_MASK; /* without the extra bit gives true size */
         retval = cc[i].handle;
     }
@@ -839,6 +866,8 @@ static int talk_year(long year, bool enqueue)
 /* stop the playback and the pending clips */
 void talk_force_shutup(void)
 {
+    if (prefetch_collect)
+        return;
     /* Had nothing to do (was frame boundary or not our clip) */
     voice_play_stop();
     talk_queue_lock();
@@ -1018,6 +1047,14 @@ int talk_id(int32_t id, bool enqueue)
     if (talk_is_disabled())
         return -1;
 
+    if (prefetch_collect)
+    {   /* only plain clips, a special ID with a value may be anything */
+        if (id >= 0 && !((uint32_t)id >> DECIMAL_SHIFT) &&
+            prefetch_count < PREFETCH_SIZE)
+            prefetch_ids[prefetch_count++] = id;
+        return 0;
+    }
+
     if (talk_handle <= 0 || index_handle <= 0) /* reload needed? */
     {
         int fd = open_voicefile();
@@ -1073,9 +1110,73 @@ int talk_idarray(const long *ids, bool enqueue)
     return 0;
 }
 
+/* Load the clip of a voice ID into the cache without playing it, so a
+   following talk_id() for it doesn't have to wait for the disk. */
+static void prefetch_clip(int32_t id)
+{
+    int index;
+    size_t clipsize;
+    struct clip_cache_metadata *cc;
+
+    /* never reload the voice file just for a prefetch */
+    if (!has_voicefile || talk_is_disabled()
+            || talk_handle <= 0 || index_handle <= 0)
+        return;
+
+    index = id2index(id);
+    if (index == -1)
+        return;
+
+    clipsize = ((struct clip_entry *)core_get_data(index_handle))[index].size;
+    if (clipsize == 0 || (clipsize & LOADED_MASK)) /* missing or cached */
+        return;
+
+    cc = load_clip(id, index, clipsize);
+    if (cc)
+    {
+        cc->prefetched = true;
+        prefetches++;
+    }
+}
+
+/* Between talk_prefetch_begin() and talk_prefetch_end() nothing is spoken,
+   the IDs that would be are only noted, replacing the ones from the last
+   time. This lets a voice callback tell what an item is going to say. */
+void talk_prefetch_begin(void)
+{
+    prefetch_count = prefetch_next = 0;
+    prefetch_collect = true;
+}
+
+void talk_prefetch_end(void)
+{
+    prefetch_collect = false;
+}
+
+/* Load the next clip noted for prefetching. Loading may evict any clip
+   from the cache and blocks on the disk, so it is only done when nothing
+   is queued to be spoken and the caller has nothing else to do. Returns
+   true while there are clips left to load. */
+bool talk_prefetch_next(void)
+{
+    if (prefetch_next >= prefetch_count)
+        return false;
+    if (!is_voice_queued())
+        prefetch_clip(prefetch_ids[prefetch_next++]);
+    return prefetch_next < prefetch_count;
+}
+
+/* Are there clips queued or playing? */
+bool is_voice_queued(void)
+{
+    return QUEUE_LEVEL != 0;
+}
+
 /* Make sure the current utterance is not interrupted by the next one. */
 void talk_force_enqueue_next(void)
 {
+    if (prefetch_collect)
+        return;
     force_enqueue_next = true;
 }
 
@@ -1094,6 +1195,10 @@ static int _talk_file(const char* filename,
     if (talk_is_disabled())
         return -1;
 
+    /* thumbnails are not prefetched */
+    if (prefetch_collect)
+        return 0;
+
     if (talk_handle <= 0 || index_handle <= 0)
     {
         fd = open_voicefile();
@@ -1755,6 +1860,8 @@ bool talk_get_debug_data(struct talk_debug_data *data)
     data->cached_clips = cached;
     data->cache_hits   = cache_hits;
     data->cache_misses = cache_misses;
+    data->prefetches    = prefetches;
+    data->prefetch_hits = prefetch_hits;
 
     return true;
 }
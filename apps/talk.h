@@ -161,6 +161,11 @@ void talk_force_enqueue_next(void);
 
 /* speaks one or more IDs (from an array)). */
 int talk_idarray(const long *idarray, bool enqueue);
+/* note what is said between these two instead of saying it, and load
+   those clips into the cache ahead of time with talk_prefetch_next() */
+void talk_prefetch_begin(void);
+void talk_prefetch_end(void);
+bool talk_prefetch_next(void);
 /* This makes an initializer for the array of IDs and takes care to
    put the final sentinel element at the end. */
 #define TALK_IDARRAY(ids...) ((long[]){ids,TALK_FINAL_ID})
@@ -194,6 +199,8 @@ struct talk_debug_data {
     int  cached_clips;
     int  cache_hits;
     int  cache_misses;
+    int  prefetches;
+    int  prefetch_hits;
     enum talk_status status;
 };
 
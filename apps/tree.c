@@ -106,19 +106,39 @@ struct entry* tree_get_entries(struct tree_context *t)
 
 struct entry* tree_get_entry_at(struct tree_context *t, int index)
 {
+    /* Load another page if the directory doesn't fit into the cache */
+    if (t->dirlength > t->filesindir &&
+        (index < t->firstpos || index >= t->firstpos + t->filesindir) &&
+        index >= 0 && index < t->dirlength)
+    {
+        if (ft_load_page(t, index) < 0)
+            return NULL;
+    }
+
+    index -= t->firstpos;
     if(index < 0 || index >= t->cache.max_entries)
         return NULL; /* no entry */
     struct entry* entries = tree_get_entries(t);
     return &entries[index];
 }
 
+/* for the list callbacks, which have to show something. The page holding
+ * the entry can fail to load if the directory changed since it was counted,
+ * so show a blank line and reload the directory. */
 static struct entry *get_valid_entry(const char* funcname,
                                      struct tree_context *t, int index)
 {
+    static char empty_name[] = "";
+    static struct entry empty_entry = { .name = empty_name };
+
     struct entry *entry = tree_get_entry_at(t, index);
+    (void)funcname;
     if (!entry)
-        panicf("Invalid tree entry %s", funcname);
-    /*DEBUGF("%s tc: %x idx: %d\n", funcname, t, index);*/
+    {
+        DEBUGF("%s: no tree entry %d\n", funcname, index);
+        reload_dir = true;
+        return &empty_entry;
+    }
     return entry;
 }
 
@@ -386,11 +406,15 @@ static int tree_get_file_position(char * filename)
         if (!strcmp(entries[i].name, filename))
 #endif
         {
-            ret = i;
+            ret = i + tc.firstpos;
             break;
         }
     }
     tree_unlock_cache(&tc);
+
+    /* only a part of a paged directory is loaded */
+    if (ret < 0 && tc.dirlength > tc.filesindir)
+        ret = ft_get_position(&tc, filename);
     return(ret);
 }
 
@@ -455,7 +479,8 @@ static int update_dir(void)
     }
     if (changed)
     {
-        if( !id3db && tc.dirfull )
+        /* paged directories aren't truncated */
+        if( !id3db && tc.dirfull && tc.dirlength == tc.filesindir )
         {
             splash(HZ, ID2P(LANG_SHOWDIR_BUFFER_FULL));
         }
@@ -518,20 +543,21 @@ static int update_dir(void)
      * with NULL and icon as NOICON as the list is reused */
     gui_synclist_set_title(list, P2STR((unsigned char*)title), icon);
 
-    gui_synclist_set_nb_items(list, tc.filesindir);
+    int nb_items = id3db ? tc.filesindir : tc.dirlength;
+    gui_synclist_set_nb_items(list, nb_items);
     gui_synclist_set_icon_callback(list,
                             global_settings.show_icons?tree_get_fileicon:NULL);
     gui_synclist_set_voice_callback(list, &tree_voice_cb);
 #ifdef HAVE_LCD_COLOR
     gui_synclist_set_color_callback(list, &tree_get_filecolor);
 #endif
-    if( tc.selected_item >= tc.filesindir)
-        tc.selected_item=tc.filesindir-1;
+    if( tc.selected_item >= nb_items)
+        tc.selected_item=nb_items-1;
 
     gui_synclist_select_item(list, tc.selected_item);
     gui_synclist_draw(list);
     gui_synclist_speak_item(list);
-    return tc.filesindir;
+    return nb_items;
 }
 
 /* load tracks from specified directory to resume play */
@@ -550,12 +576,15 @@ void resume_directory(const char *dir)
     if (!id3db)
         *tc.dirfilter = global_settings.dirfilter;
     ret = ft_load(&tc, dir);
+    if (ret >= 0)
+    {
+        lastdir[0] = 0;
+        /* the pages of a big directory are read with the same filter */
+        ft_build_playlist(&tc, 0);
+    }
     *tc.dirfilter = dirfilter;
     if (ret < 0)
         return;
-    lastdir[0] = 0;
-
-    ft_build_playlist(&tc, 0);
 
 #ifdef HAVE_TAGCACHE
     if (id3db)
@@ -788,8 +817,12 @@ static int dirbrowse(void)
                     break;
                 if (tc.browse->flags & BROWSE_SELECTONLY)
                 {
-                    struct entry *entry =
-                                get_valid_entry(__func__, &tc, tc.selected_item);
+                    struct entry *entry = tree_get_entry_at(&tc, tc.selected_item);
+                    if (!entry)
+                    {
+                        reload_dir = true;
+                        break;
+                    }
                     short attr = entry->attr;
                     if(!(attr & ATTR_DIRECTORY))
                     {
@@ -960,7 +993,12 @@ static int dirbrowse(void)
 #endif
                     {
                         struct entry *entry =
-                               get_valid_entry(__func__, &tc, tc.selected_item);
+                               tree_get_entry_at(&tc, tc.selected_item);
+                        if (!entry)
+                        {
+                            reload_dir = true;
+                            break;
+                        }
 
                         attr = entry->attr;
 
@@ -90,6 +90,7 @@ struct tree_context {
     int filesindir; /* The number of files in the dircache */
     int dirsindir; /* file use */
     int dirlength; /* total number of entries in dir, incl. those not loaded */
+    int firstpos; /* file use: list position of the first loaded entry */
 #ifdef HAVE_TAGCACHE
     int currtable; /* db use */
     int currextra; /* db use */
@@ -237,6 +237,35 @@ void lcd_yuv_set_options(unsigned options)
     (void)options;
 }
 
+/* Step in the framebuffer to the next source column and row */
+#if LCD_WIDTH >= LCD_HEIGHT
+#define YUV_COL 1
+#define YUV_ROW LCD_WIDTH
+#else
+#define YUV_COL LCD_WIDTH
+#define YUV_ROW (-1)
+#endif
+
+/* Convert one luma sample with precomputed chroma terms */
+static FORCE_INLINE fb_data yuv_pixel(int y, int rv, int guv, int bu)
+{
+    int r, g, b;
+
+    y = YFAC*(y - 16);
+    r = y + rv;
+    g = y + guv;
+    b = y + bu;
+
+    if ((unsigned)(r | g | b) > 64*256-1)
+    {
+        r = clamp(r, 0, 64*256-1);
+        g = clamp(g, 0, 64*256-1);
+        b = clamp(b, 0, 64*256-1);
+    }
+
+    return FB_RGBPACK(r >> 6, g >> 6, b >> 6);
+}
+
 /* Draw a partial YUV colour bitmap */
 #ifndef _WIN32
 __attribute__((weak))
@@ -268,18 +297,17 @@ void lcd_blit_yuv(unsigned char * const src[3],
     usrc = src[1] + (z >> 2) + (src_x >> 1);
     vsrc = src[2] + (usrc - src[1]);
 
-    /* stride => amount to jump from end of last row to start of next */
-    stride -= width;
-
-    /* upsampling, YUV->RGB conversion and reduction to RGB565 in one go */
+    /* upsampling, YUV->RGB conversion and reduction to RGB565 in one go,
+     * two rows at a time so each chroma sample is only converted once */
 
     do
     {
-        int y, cb, cr, rv, guv, bu, r, g, b;
+        const unsigned char *ysrc2 = ysrc + stride;
+        fb_data *dst2 = dst + YUV_ROW;
+        int cb, cr, rv, guv, bu;
 
         do
         {
-            y  = YFAC*(*ysrc++ - 16);
             cb = *usrc++ - 128;
             cr = *vsrc++ - 128;
 
@@ -287,120 +315,28 @@ void lcd_blit_yuv(unsigned char * const src[3],
             guv = GUFAC*cb + GVFAC*cr;
             bu  = BUFAC*cb;
 
-            r = y + rv;
-            g = y + guv;
-            b = y + bu;
-
-            if ((unsigned)(r | g | b) > 64*256-1)
-            {
-                r = clamp(r, 0, 64*256-1);
-                g = clamp(g, 0, 64*256-1);
-                b = clamp(b, 0, 64*256-1);
-            }
-
-            *dst = FB_RGBPACK(r >> 6, g >> 6, b >> 6);
-
-#if LCD_WIDTH >= LCD_HEIGHT
-            dst++;
-#else
-            dst += LCD_WIDTH;
-#endif
-
-            y = YFAC*(*ysrc++ - 16);
-            r = y + rv;
-            g = y + guv;
-            b = y + bu;
-
-            if ((unsigned)(r | g | b) > 64*256-1)
-            {
-                r = clamp(r, 0, 64*256-1);
-                g = clamp(g, 0, 64*256-1);
-                b = clamp(b, 0, 64*256-1);
-            }
-
-            *dst = FB_RGBPACK(r >> 6, g >> 6, b >> 6);
-
-#if LCD_WIDTH >= LCD_HEIGHT
-            dst++;
-#else
-            dst += LCD_WIDTH;
-#endif
-        }
-        while (dst < row_end);
+            dst[0]           = yuv_pixel(ysrc[0], rv, guv, bu);
+            dst[YUV_COL]     = yuv_pixel(ysrc[1], rv, guv, bu);
+            dst2[0]          = yuv_pixel(ysrc2[0], rv, guv, bu);
+            dst2[YUV_COL]    = yuv_pixel(ysrc2[1], rv, guv, bu);
 
-        ysrc    += stride;
-        usrc    -= width >> 1;
-        vsrc    -= width >> 1;
-
-#if LCD_WIDTH >= LCD_HEIGHT
-        row_end += LCD_WIDTH;
-        dst     += LCD_WIDTH - width;
-#else
-        row_end -= 1;
-        dst     -= LCD_WIDTH*width + 1;
-#endif
-
-        do
-        {
-            y  = YFAC*(*ysrc++ - 16);
-            cb = *usrc++ - 128;
-            cr = *vsrc++ - 128;
-
-            rv  =            RVFAC*cr;
-            guv = GUFAC*cb + GVFAC*cr;
-            bu  = BUFAC*cb;
-
-            r = y + rv;
-            g = y + guv;
-            b = y + bu;
-
-            if ((unsigned)(r | g | b) > 64*256-1)
-            {
-                r = clamp(r, 0, 64*256-1);
-                g = clamp(g, 0, 64*256-1);
-                b = clamp(b, 0, 64*256-1);
-            }
-
-            *dst = FB_RGBPACK(r >> 6, g >> 6, b >> 6);
-
-#if LCD_WIDTH >= LCD_HEIGHT
-            dst++;
-#else
-            dst += LCD_WIDTH;
-#endif
-
-            y = YFAC*(*ysrc++ - 16);
-            r = y + rv;
-            g = y + guv;
-            b = y + bu;
-
-            if ((unsigned)(r | g | b) > 64*256-1)
-            {
-                r = clamp(r, 0, 64*256-1);
-                g = clamp(g, 0, 64*256-1);
-                b = clamp(b, 0, 64*256-1);
-            }
-
-            *dst = FB_RGBPACK(r >> 6, g >> 6, b >> 6);
-
-#if LCD_WIDTH >= LCD_HEIGHT
-            dst++;
-#else
-            dst += LCD_WIDTH;
-#endif
+            ysrc  += 2;
+            ysrc2 += 2;
+            dst   += 2*YUV_COL;
+            dst2  += 2*YUV_COL;
         }
         while (dst < row_end);
 
-        ysrc    += stride;
-        usrc    += stride >> 1;
-        vsrc    += stride >> 1;
+        ysrc    += 2*stride - width;
+        usrc    += (stride - width) >> 1;
+        vsrc    += (stride - width) >> 1;
 
 #if LCD_WIDTH >= LCD_HEIGHT
-        row_end += LCD_WIDTH;
-        dst     += LCD_WIDTH - width;
+        row_end += 2*LCD_WIDTH;
+        dst     += 2*LCD_WIDTH - width;
 #else
-        row_end -= 1;
-        dst     -= LCD_WIDTH*width + 1;
+        row_end -= 2;
+        dst     -= LCD_WIDTH*width + 2;
 #endif
     }
     while (--linecounter > 0);
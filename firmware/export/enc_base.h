@@ -111,12 +111,26 @@ extern const unsigned long mp3_enc_bitr[MP3_ENC_NUM_BITR];
 struct mp3_enc_config
 {
     unsigned long bitrate;
+    int speed;              /* MP3_ENC_SPEED_* */
 };
 
 #define MP3_ENC_BITRATE_CFG_DEFAULT     11 /* 128 */
 #define MP3_ENC_BITRATE_CFG_VALUE_LIST  "8,16,24,32,40,48,56,64,80,96," \
                                         "112,128,144,160,192,224,256,320"
 
+/* Encoder speed presets - trade quantization search effort and MDCT
+   precision passes for encoding time */
+enum mp3_enc_speed
+{
+    MP3_ENC_SPEED_NORMAL = 0,   /* best quality */
+    MP3_ENC_SPEED_FAST,
+    MP3_ENC_SPEED_VERY_FAST,
+    MP3_ENC_NUM_SPEED,
+};
+
+#define MP3_ENC_SPEED_CFG_DEFAULT       MP3_ENC_SPEED_NORMAL
+#define MP3_ENC_SPEED_CFG_VALUE_LIST    "normal,fast,very_fast"
+
 /** wav_enc.codec **/
 #define WAV_ENC_SAMPR_CAPS      SAMPR_CAP_ALL
 
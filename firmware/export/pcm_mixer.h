@@ -134,6 +134,15 @@ typedef void (*chan_buffer_hook_fn_type)(const void *start, size_t size);
 void mixer_channel_set_buffer_hook(enum pcm_mixer_channel channel,
                                    chan_buffer_hook_fn_type fn);
 
+/* Set a ring buffer that receives a copy of the mixed output as it is
+   queued for playback (stereo 16-bit samples), or NULL to remove it.
+   The buffer must be 4-byte aligned. */
+void mixer_set_output_tap(void *buf, size_t size);
+
+/* Return the number of samples written to the output tap since it was set;
+   the most recent one is at (position - 1) % ring size */
+unsigned long mixer_get_output_tap_pos(void);
+
 /* Stop ALL channels and PCM and reset state */
 void mixer_reset(void);
 
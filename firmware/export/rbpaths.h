@@ -122,6 +122,7 @@
 
 #define RESUMEFILE          ROCKBOX_DIR "/.resume.cfg"
 #define CONFIGFILE          ROCKBOX_DIR "/config.cfg"
+#define CONFIGSNAPSHOT      ROCKBOX_DIR "/.config.bin"
 #define FIXEDSETTINGSFILE   ROCKBOX_DIR "/fixed.cfg"
 
 #define PLAYLIST_CONTROL_FILE   ROCKBOX_DIR "/.playlist_control"
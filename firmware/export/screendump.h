@@ -56,6 +56,8 @@
 
 /* Save a .BMP file containing the current screen contents. */
 void screen_dump(void);
+/* Same, to the given file instead of a new one in the home directory */
+void screen_dump_file(const char *filename);
 
 void screen_dump_set_hook(void (*hook)(int fd));
 
@@ -67,6 +69,7 @@ void remote_screen_dump(void);
 #else /* !HAVE_SCREENDUMP */
 
 #define screen_dump() do { } while(0)
+#define screen_dump_file(filename) do { (void)(filename); } while(0)
 #define remote_screen_dump() do { } while(0)
 
 #endif /* HAVE_SCREENDUMP */
@@ -26,5 +26,9 @@
  * You can change this typedef, but must then also change the inline
  * functions in strnatcmp.c */
 
+#include <stdbool.h>
+#include <stddef.h>
+
 int strnatcmp(const char *a, const char *b);
 int strnatcasecmp(const char *a, const char *b);
+size_t strnatkey(char *key, const char *str, bool ignore_case);
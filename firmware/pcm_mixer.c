@@ -74,6 +74,11 @@ static struct mixer_channel channels[PCM_MIXER_NUM_CHANNELS] IBSS_ATTR;
 /* Packed pointer array of all playing (active) channels in "channels" array */
 static struct mixer_channel * active_channels[PCM_MIXER_NUM_CHANNELS+1] IBSS_ATTR;
 
+/* Optional ring buffer receiving a copy of every mixed output frame */
+static uint32_t *tap_buf = NULL;
+static size_t tap_count = 0;            /* Ring size in samples */
+static unsigned long tap_pos = 0;       /* Samples written since it was set */
+
 /* Number of silence frames to play after all data has played */
 #define MAX_IDLE_FRAMES     (mixer_sampr*3 / (mix_frame_size / 4))
 static unsigned int idle_counter = 0;
@@ -123,6 +128,32 @@ static inline void chan_call_buffer_hook(struct mixer_channel *chan)
         chan->buffer_hook(chan->start, chan->size);
 }
 
+/* Append a finished frame to the output tap */
+static void mixer_tap_frame(const uint32_t *src, size_t size)
+{
+    size_t count = size / 4;
+    size_t index = tap_pos % tap_count;
+
+    tap_pos += count;
+
+    if (count > tap_count)
+    {
+        /* Only the end of the frame fits */
+        index = (index + count - tap_count) % tap_count;
+        src += count - tap_count;
+        count = tap_count;
+    }
+
+    while (count > 0)
+    {
+        size_t n = MIN(count, tap_count - index);
+        memcpy(&tap_buf[index], src, n*4);
+        src += n;
+        count -= n;
+        index = 0;
+    }
+}
+
 /* Buffering callback - calls sub-callbacks and mixes the data for next
    buffer to be sent from mixer_pcm_callback() */
 static enum pcm_dma_status MIXER_CALLBACK_ICODE
@@ -248,6 +279,9 @@ fill_frame:
         *downmix_buf[downmix_index] = downmix_index ? 0x7fff7fff : 0x80008000;
 #endif
 
+    if (tap_buf && next_size)
+        mixer_tap_frame(downmix_buf[downmix_index], next_size);
+
     /* Certain SoC's have to do cleanup */
     mixer_buffer_callback_exit();
 
@@ -438,6 +472,26 @@ void mixer_channel_set_buffer_hook(enum pcm_mixer_channel channel,
     pcm_play_unlock();
 }
 
+/* Set a ring buffer that receives a copy of the mixed output as it is
+   queued for playback, or NULL to remove it */
+void mixer_set_output_tap(void *buf, size_t size)
+{
+    pcm_play_lock();
+
+    tap_count = size / 4;
+    tap_buf = tap_count ? buf : NULL;
+    tap_pos = 0;
+
+    pcm_play_unlock();
+}
+
+/* Return the number of samples written to the output tap since it was set;
+   the most recent one is at (position - 1) % ring size */
+unsigned long mixer_get_output_tap_pos(void)
+{
+    return *(unsigned long volatile *)&tap_pos;
+}
+
 /* Stop ALL channels and PCM and reset state */
 void mixer_reset(void)
 {
@@ -101,9 +101,21 @@ static void (*screen_dump_hook)(int fh) = NULL;
 
 void screen_dump(void)
 {
-    int fd, y;
     char filename[MAX_PATH];
 
+#if CONFIG_RTC
+    create_datetime_filename(filename, HOME_DIR, "dump ", ".bmp", false);
+#else
+    create_numbered_filename(filename, HOME_DIR, "dump_", ".bmp", 4
+                             IF_CNFN_NUM_(, NULL));
+#endif
+
+    screen_dump_file(filename);
+}
+
+void screen_dump_file(const char *filename)
+{
+    int fd, y;
     fb_data *src;
 #if LCD_DEPTH == 1
     unsigned mask;
@@ -123,13 +135,6 @@ void screen_dump(void)
     unsigned char linebuf[DUMP_BMP_LINESIZE * 3];
 #endif
 
-#if CONFIG_RTC
-    create_datetime_filename(filename, HOME_DIR, "dump ", ".bmp", false);
-#else
-    create_numbered_filename(filename, HOME_DIR, "dump_", ".bmp", 4
-                             IF_CNFN_NUM_(, NULL));
-#endif
-
     fd = creat(filename, 0666);
     if (fd < 0)
         return;
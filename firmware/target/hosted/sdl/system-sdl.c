@@ -71,6 +71,16 @@ bool            debug_buttons = false;
 
 bool            sim_alarm_wakeup = false;
 const char     *sim_root_dir = SIMULATOR_DEFAULT_ROOT;
+int             sim_exit_status = EXIT_SUCCESS;
+
+#ifdef SIMULATOR
+/* headless skin rendering, see apps/gui/skin_engine/skin_headless.c */
+const char     *sim_render_skin = NULL;
+const char     *sim_render_track = NULL;
+const char     *sim_render_dumpdir = NULL;
+const char     *sim_render_refdir = NULL;
+int             sim_render_frames = 1;
+#endif
 
 static SDL_Thread *evt_thread = NULL;
 
@@ -235,8 +245,23 @@ void sim_do_exit()
 #endif
 
     SDL_Quit();
-    exit(EXIT_SUCCESS);
+    exit(sim_exit_status);
+}
+
+#ifdef SIMULATOR
+/* microseconds from an arbitrary start, for timing things in the simulator
+ * more finely than current_tick does */
+uint64_t sim_get_usec(void)
+{
+#if SDL_MAJOR_VERSION > 1
+    uint64_t count = SDL_GetPerformanceCounter();
+    uint64_t freq = SDL_GetPerformanceFrequency();
+    return count / freq * 1000000 + count % freq * 1000000 / freq;
+#else
+    return (uint64_t)SDL_GetTicks() * 1000;
+#endif
 }
+#endif
 
 uintptr_t *stackbegin;
 uintptr_t *stackend;
@@ -423,6 +448,38 @@ void sys_handle_argv(int argc, char *argv[])
                     printf("Audio device: '%s'\n", audiodev);
                 }
             }
+#ifdef SIMULATOR
+            else if (!strcmp("--renderskin", argv[x]))
+            {
+                x++;
+                if (x < argc)
+                    sim_render_skin = argv[x];
+            }
+            else if (!strcmp("--track", argv[x]))
+            {
+                x++;
+                if (x < argc)
+                    sim_render_track = argv[x];
+            }
+            else if (!strcmp("--frames", argv[x]))
+            {
+                x++;
+                if (x < argc)
+                    sim_render_frames = atoi(argv[x]);
+            }
+            else if (!strcmp("--dumpdir", argv[x]))
+            {
+                x++;
+                if (x < argc)
+                    sim_render_dumpdir = argv[x];
+            }
+            else if (!strcmp("--refdir", argv[x]))
+            {
+                x++;
+                if (x < argc)
+                    sim_render_refdir = argv[x];
+            }
+#endif
             else
             {
                 printf("rockboxui\n");
@@ -440,10 +497,31 @@ void sys_handle_argv(int argc, char *argv[])
                 printf("  --root [DIR]\t Set root directory\n");
                 printf("  --mapping \t Output coordinates and radius for mapping backgrounds\n");
                 printf("  --audiodev [NAME] \t Audio device name to use\n");
+#ifdef SIMULATOR
+                printf("  --renderskin [FILE]\t Render a WPS without a window and exit\n");
+                printf("  --track [FILE]\t Track info to render the WPS with\n");
+                printf("  --frames [N]\t Number of frames to render\n");
+                printf("  --dumpdir [DIR]\t Save every rendered frame as a BMP\n");
+                printf("  --refdir [DIR]\t Compare the frames against earlier dumps\n");
+#endif
                 exit(0);
             }
         }
     }
+#ifdef SIMULATOR
+    if (sim_render_skin)
+    {
+        /* nobody looks at the window or listens while rendering */
+#if SDL_MAJOR_VERSION > 1
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+#else
+        SDL_putenv("SDL_VIDEODRIVER=dummy");
+        SDL_putenv("SDL_AUDIODRIVER=dummy");
+#endif
+        background = false;
+    }
+#endif
 #if SDL_MAJOR_VERSION > 1
     if (display_zoom != 1) {
         background = false;
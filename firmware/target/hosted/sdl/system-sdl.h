@@ -62,5 +62,17 @@ extern bool background;  /* True if the background image is enabled */
 extern bool showremote;
 extern double display_zoom;
 extern long start_tick;
+extern int sim_exit_status; /* passed to exit() by sim_do_exit() */
+
+#ifdef SIMULATOR
+/* headless skin rendering, see apps/gui/skin_engine/skin_headless.c */
+extern const char *sim_render_skin;
+extern const char *sim_render_track;
+extern const char *sim_render_dumpdir;
+extern const char *sim_render_refdir;
+extern int sim_render_frames;
+
+uint64_t sim_get_usec(void);
+#endif
 
 #endif /* _SYSTEM_SDL_H_ */
@@ -91,6 +91,9 @@ typedef struct
     int      flush_frames;
     int      delay;
     int      padding;
+    unsigned num_lines;   /* coded spectral lines: num_bands*18, rest is 0 */
+    int      bits_slack;  /* unused bits tolerated by the quantizer search */
+    int      mdct_passes; /* max. MDCT passes spent on integer precision */
 } config_t;
 
 typedef struct
@@ -907,6 +910,17 @@ static const int num_bands[3][15]  =
   { 0,10,10,10,10,10,12,14,18,24,26,28,30,32,32 },   /* MPEG 1 Stereo */
   { 0,10,12,14,18,24,26,28,30,32,32,32,32,32,32 } }; /* MPEG 1&2 Mono */
 
+static const struct
+{
+    int bits_slack;
+    int mdct_passes;
+} speed_presets[MP3_ENC_NUM_SPEED] =
+{
+    [MP3_ENC_SPEED_NORMAL]    = {  64, 3 },
+    [MP3_ENC_SPEED_FAST]      = { 128, 2 },
+    [MP3_ENC_SPEED_VERY_FAST] = { 256, 1 },
+};
+
 
 #ifdef MP3_ENC_COP
 /* Initialize the circular buffer pointers */
@@ -1422,7 +1436,7 @@ static int choose_table(short *ix, uint32_t begin, uint32_t end, int *bits)
 /*************************************************************************/
 static int calc_runlen(short *ix, side_info_t *si)
 {
-    int i = 576;
+    int i = cfg.num_lines; /* everything above is always zero */
 
     while (i -= 2)
     {
@@ -1483,13 +1497,13 @@ static int quantize_int(int *xr, short *ix, side_info_t *si)
     if (((si->max_val + 256) >> 8) * s < (4096 << 8))
     {
         /* all values fit the table size */
-        for (int i = 576; i--; )
+        for (int i = cfg.num_lines; i--; )
             ix[i] = int2idx[(xr[i] * s + 0x8000) >> 16];
     }
     else
     {
         /* check each index wether it fits the table */
-        for (int i = 576; i--; )
+        for (int i = cfg.num_lines; i--; )
         {
             unsigned idx = (xr[i] * s + 0x08000) >> 16;
 
@@ -1574,7 +1588,8 @@ static int inner_loop(int *xr, int max_bits, side_info_t *si)
 {
     int bits;
 
-    while ((bits = quantize_and_count_bits(xr, enc_data, si)) < max_bits - 64)
+    while ((bits = quantize_and_count_bits(xr, enc_data, si)) <
+           max_bits - cfg.bits_slack)
     {
         if (si->quantStep == 0)
             break;
@@ -2284,7 +2299,7 @@ static void mp3_encoder_reset(void)
 }
 
 static void mp3_encoder_init(unsigned long sample_rate, int num_channels,
-                             unsigned long bitrate)
+                             unsigned long bitrate, int speed)
 {
     mp3_encoder_reset();
 
@@ -2297,6 +2312,13 @@ static void mp3_encoder_init(unsigned long sample_rate, int num_channels,
     cfg.mpg.bitr_id    = find_bitrate_index(cfg.mpg.type, bitrate, stereo);
     cfg.mpg.bitrate    = bitr_index[cfg.mpg.type][cfg.mpg.bitr_id];
     cfg.mpg.num_bands  = num_bands[stereo ? cfg.mpg.type : 2][cfg.mpg.bitr_id];
+    cfg.num_lines      = cfg.mpg.num_bands * 18;
+
+    if ((unsigned)speed >= MP3_ENC_NUM_SPEED)
+        speed = MP3_ENC_SPEED_NORMAL;
+
+    cfg.bits_slack     = speed_presets[speed].bits_slack;
+    cfg.mdct_passes    = speed_presets[speed].mdct_passes;
 
     if (cfg.mpg.type == 1)
     {
@@ -2483,7 +2505,7 @@ static void ICODE_ATTR compress_frame(void)
 
                 uint32_t max = 0;
 
-                for (int k = 0; k < 576; k++)
+                for (unsigned int k = 0; k < cfg.num_lines; k++)
                 {
                     if (mdct_freq[k] < 0)
                     {
@@ -2508,6 +2530,10 @@ static void ICODE_ATTR compress_frame(void)
                 while ((max >> i) >= 0x10000u) i++, shift++;
                 if (i == 0) break;
                 if (shift < 0) shift = 0;
+
+                /* a pass for more precision is optional, one to avoid
+                   overflowing the quantizer is not */
+                if (ii + 1 >= cfg.mdct_passes && max < 0x10000u) break;
             }
 
             cfg.cod_info[gr][ch].quantStep +=
@@ -3050,7 +3076,8 @@ int enc_callback(enum enc_callback_reason reason, void *params)
         struct enc_inputs *inputs = params;
 
         mp3_encoder_init(inputs->sample_rate, inputs->num_channels,
-                         inputs->config->mp3_enc.bitrate);
+                         inputs->config->mp3_enc.bitrate,
+                         inputs->config->mp3_enc.speed);
 
         /* Return the actual configuration */
         inputs->enc_sample_rate = cfg.samplerate;
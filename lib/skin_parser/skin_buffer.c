@@ -92,6 +92,15 @@ void* skin_buffer_alloc(size_t size)
     return retval;
 }
 
+/* Give back the most recent allocation, pointer must be the value the last
+ * skin_buffer_alloc() call returned */
+void skin_buffer_unalloc(void *pointer)
+{
+    if ((unsigned char*)pointer >= buffer_start &&
+        (unsigned char*)pointer < buffer_front)
+        buffer_front = pointer;
+}
+
 /* get the number of bytes currently being used */
 size_t skin_buffer_usage(void)
 {
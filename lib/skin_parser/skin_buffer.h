@@ -51,6 +51,9 @@ void* skin_buffer_alloc_ex(size_t size, char* str);
 void* skin_buffer_alloc(size_t size);
 #endif
 
+#ifdef ROCKBOX
+void skin_buffer_unalloc(void *pointer);
+#endif
 
 /* get the number of bytes currently being used */
 size_t skin_buffer_usage(void);
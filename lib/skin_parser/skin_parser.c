@@ -41,6 +41,12 @@ static int viewport_line = 0;
 static int empty_callback(struct skin_element* element, void* data);
 static skin_callback callback = &empty_callback;
 static void* callback_data = NULL;
+
+/* The skin buffer is never freed piecemeal, so text and string parameters
+ * which show up more than once in a theme can share a single copy */
+#define INTERN_SLOTS 64
+static char* interned[INTERN_SLOTS];
+static char* skin_intern_string(char* string);
 #endif
 
 /* Auxiliary parsing functions (not visible at global scope) */
@@ -84,6 +90,7 @@ struct skin_element* skin_parse(const char* document,
 {
     callback = cb;
     callback_data = cb_data;
+    memset(interned, 0, sizeof(interned));
 #else
 struct skin_element* skin_parse(const char* document)
 {
@@ -128,6 +135,172 @@ struct skin_element* skin_parse(const char* document)
 
 }
 
+#ifndef ROCKBOX
+/* Moves the line numbers of a list of elements and all their children */
+static void skin_shift_lines(struct skin_element* element, int delta)
+{
+    int i;
+
+    for(; element; element = element->next)
+    {
+        element->line += delta;
+
+        for(i = 0; i < element->children_count; i++)
+            skin_shift_lines(element->children[i], delta);
+
+        for(i = 0; i < element->params_count; i++)
+            if(element->params[i].type == CODE)
+                skin_shift_lines(element->params[i].data.code, delta);
+    }
+}
+
+/* Parses the whole document, replacing tree if that succeeds */
+static struct skin_element* skin_parse_replace(struct skin_element* tree,
+                                               const char* document)
+{
+    struct skin_element* root = skin_parse(document);
+
+    if(root)
+        skin_free_tree(tree);
+    return root;
+}
+
+/* Returns the start of a line of the document, or NULL if it is too short */
+static const char* skin_find_line(const char* document, int line)
+{
+    while(--line > 0)
+    {
+        document = strchr(document, '\n');
+        if(!document)
+            return NULL;
+        document++;
+    }
+    return document;
+}
+
+/* Checks if a viewport starts at the beginning of a line, viewport tags in
+ * the middle of a line end the previous viewport there as well */
+static bool skin_starts_line(const struct skin_element* prev,
+                             const struct skin_element* viewport,
+                             const char* document, int line_delta)
+{
+    const char* start;
+
+    if(prev && prev->line == viewport->line)
+        return false;
+    start = skin_find_line(document, viewport->line + line_delta);
+    return start && check_viewport(start);
+}
+
+struct skin_element* skin_reparse(struct skin_element* tree,
+                                  const char* document, int first_line,
+                                  int last_line, int line_delta)
+{
+    struct skin_element* keep = NULL;  /* Last viewport kept before the edit */
+    struct skin_element* old_first;    /* First viewport being replaced */
+    struct skin_element* old_last;     /* Last viewport being replaced */
+    struct skin_element* suffix;       /* First viewport kept after the edit */
+    struct skin_element* root = NULL;
+    struct skin_element* last = NULL;
+    const char* cursor;
+    const char* start;
+    const char* end;
+
+    if(!tree)
+        return skin_parse(document);
+
+    /* A viewport ends where the next one starts, so it can only be kept if
+     * the next one starts before the edit as well */
+    old_first = tree;
+    while(old_first->next && old_first->next->line < first_line)
+    {
+        keep = old_first;
+        old_first = old_first->next;
+    }
+
+    /* Parsing has to start at the beginning of a line */
+    while(keep && !skin_starts_line(keep, old_first, document, 0))
+    {
+        old_first = keep;
+        for(keep = tree; keep && keep->next != old_first; keep = keep->next)
+            ;
+    }
+
+    /* Viewports starting after the edit are unchanged apart from their
+     * position */
+    old_last = old_first;
+    while(old_last->next && old_last->next->line <= last_line - line_delta)
+        old_last = old_last->next;
+    suffix = old_last->next;
+    while(suffix && !skin_starts_line(old_last, suffix, document, line_delta))
+    {
+        old_last = suffix;
+        suffix = suffix->next;
+    }
+
+    /* Finding the text of the replaced viewports in the new document */
+    start = skin_find_line(document, old_first->line);
+    if(suffix)
+        end = skin_find_line(document, suffix->line + line_delta);
+    else
+        end = document + strlen(document);
+    if(!start || !end)
+        return skin_parse_replace(tree, document);
+
+    skin_line = old_first->line;
+    skin_start = (char*)document;
+    viewport_line = 0;
+
+    skin_clear_errors();
+
+    cursor = start;
+    while(*cursor != '\0' && cursor < end)
+    {
+        struct skin_element* viewport = skin_parse_viewport(&cursor);
+        if(!viewport)
+        {
+            skin_free_tree(root);
+            return NULL;
+        }
+
+        if(!root)
+            root = viewport;
+        else
+            last->next = viewport;
+        last = viewport;
+    }
+
+    /* The edit changed where the following viewports start after all */
+    if(cursor != end)
+    {
+        skin_free_tree(root);
+        return skin_parse_replace(tree, document);
+    }
+
+    /* An empty document doesn't parse, same as with skin_parse() */
+    if(!root && !keep && !suffix)
+        return NULL;
+
+    /* Splicing the new viewports in place of the old ones */
+    old_last->next = NULL;
+    skin_free_tree(old_first);
+
+    if(line_delta)
+        skin_shift_lines(suffix, line_delta);
+
+    if(last)
+        last->next = suffix;
+    else
+        root = suffix;
+
+    if(!keep)
+        return root;
+
+    keep->next = root;
+    return tree;
+}
+#endif
+
 static struct skin_element* skin_parse_viewport(const char** document)
 {
     struct skin_element* root = NULL;
@@ -748,7 +921,12 @@ static int skin_parse_tag(struct skin_element* element, const char** document)
         {
             /* Scanning a string argument */
             params[i].type = STRING;
+#ifdef ROCKBOX
+            params[i].data.text =
+                skin_buffer_to_offset(skin_intern_string(scan_string(&cursor)));
+#else
             params[i].data.text = skin_buffer_to_offset(scan_string(&cursor));
+#endif
 
         }
         else if(tolower(type_code) == 'c')
@@ -890,6 +1068,8 @@ static int skin_parse_text(struct skin_element* element, const char** document,
     text[length] = '\0';
 
 #ifdef ROCKBOX
+    text = skin_intern_string(text);
+    element->data = skin_buffer_to_offset(text);
     if (callback(element, callback_data) == CALLBACK_ERROR)
     {
         skin_error(GOT_CALLBACK_ERROR, *document);
@@ -1162,6 +1342,31 @@ char* skin_alloc_string(int length)
     return (char*)skin_buffer_alloc(sizeof(char) * (length + 1));
 }
 
+#ifdef ROCKBOX
+/* string must be the last thing allocated from the skin buffer. If an equal
+ * string was seen before it is given back and the earlier copy returned */
+static char* skin_intern_string(char* string)
+{
+    unsigned int hash = 0;
+    const char *c;
+    char **slot;
+
+    if (!string)
+        return NULL;
+    for (c = string; *c; c++)
+        hash = hash * 31 + (unsigned char)*c;
+    slot = &interned[hash % INTERN_SLOTS];
+
+    if (*slot && !strcmp(*slot, string))
+    {
+        skin_buffer_unalloc(string);
+        return *slot;
+    }
+    *slot = string;
+    return string;
+}
+#endif
+
 static OFFSETTYPE(struct skin_element*)* skin_alloc_children(int count)
 {
     return (OFFSETTYPE(struct skin_element*)*)
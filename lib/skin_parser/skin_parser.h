@@ -105,7 +105,7 @@ struct skin_tag_parameter
         STRING,
         CODE,
         DEFAULT
-    } type;
+    } type : 8;
 
     char type_code;
 
@@ -142,8 +142,9 @@ struct skin_element
     short children_count;
     /* The line on which it's defined in the source file */
     short line;
-    /* Defines what type of element it is */
-    enum skin_element_type type;
+    /* Defines what type of element it is, kept to a byte so it packs
+     * with the fields around it */
+    enum skin_element_type type : 8;
     /* Number of elements in the params array */
     char params_count;
     bool is_conditional;
@@ -170,6 +171,17 @@ struct skin_element* skin_parse(const char* document,
 #else
 struct skin_element* skin_parse(const char* document);
 #endif
+#ifndef ROCKBOX
+/* Parses a changed document again, starting from the tree of its previous
+ * version. Lines first_line to last_line (counted in the new document) were
+ * edited and line_delta lines were added in total. Only the viewports
+ * touching those lines are parsed again, the others are kept and moved to
+ * their new line numbers. Returns the new tree, or NULL on a parse error in
+ * which case tree is left as it was. */
+struct skin_element* skin_reparse(struct skin_element* tree,
+                                  const char* document, int first_line,
+                                  int last_line, int line_delta);
+#endif
 /* Memory management functions */
 char* skin_alloc_string(int length);
 
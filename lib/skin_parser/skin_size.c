@@ -0,0 +1,273 @@
+/***************************************************************************
+ *             __________               __   ___.
+ *   Open      \______   \ ____   ____ |  | _\_ |__   _______  ___
+ *   Source     |       _//  _ \_/ ___\|  |/ /| __ \ /  _ \  \/  /
+ *   Jukebox    |    |   (  <_> )  \___|    < | \_\ (  <_> > <  <
+ *   Firmware   |____|_  /\____/ \___  >__|_ \|___  /\____/__/\_ \
+ *                     \/            \/     \/    \/            \/
+ * $Id$
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF ANY
+ * KIND, either express or implied.
+ *
+ ****************************************************************************/
+
+/* Reports how many bytes of skin buffer the parse tree of a theme file
+ * takes. The parser is built in ROCKBOX mode for this, like checkwps does,
+ * so the "after" figure is the real skin_buffer_usage() of the parse, with
+ * equal strings shared. The "before" figure adds back what the old layout
+ * (int sized type fields, every string copied) took on top of that. Only
+ * the parser's own allocations are counted, not what the skin engine
+ * callbacks add on top.
+ *
+ * Pointer sizes and alignment are those of the host. Build with
+ * "make skin_size CC='gcc -m32'" to see the figures of a 32 bit target,
+ * and run "skin_size file.wps [file.sbs ...]"
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "skin_buffer.h"
+#include "skin_parser.h"
+#include "skin_debug.h"
+
+#define SKIN_BUFFER_SIZE    (4*1024*1024)
+
+/* skin_buffer_alloc() rounds every allocation up to a long */
+#define ALIGN(x)            (((x) + sizeof(long) - 1) & ~(sizeof(long) - 1))
+
+/* the tree nodes as they were before the type fields were packed */
+struct old_skin_tag_parameter
+{
+    int type;
+    char type_code;
+    union
+    {
+        int number;
+        OFFSETTYPE(char*) text;
+        OFFSETTYPE(struct skin_element*) code;
+    } data;
+};
+
+struct old_skin_element
+{
+    OFFSETTYPE(struct skin_element*) next;
+    OFFSETTYPE(struct skin_element**) children;
+    OFFSETTYPE(void*) data;
+    const struct tag_info *tag;
+    OFFSETTYPE(struct skin_tag_parameter*) params;
+    short children_count;
+    short line;
+    enum skin_element_type type;
+    char params_count;
+    bool is_conditional;
+};
+
+struct skin_size
+{
+    int elements;
+    int params;
+    int strings;
+    int shared;
+    unsigned long old_bytes;
+    unsigned long new_bytes;
+};
+
+/* every string the tree refers to, shared ones more than once */
+static const char **strings;
+static int strings_count;
+static int strings_max;
+
+static void add_string(const char *string)
+{
+    if (strings_count == strings_max)
+    {
+        strings_max = strings_max ? 2 * strings_max : 256;
+        strings = realloc(strings, strings_max * sizeof(*strings));
+        if (!strings)
+        {
+            printf("out of memory\n");
+            exit(1);
+        }
+    }
+    strings[strings_count++] = string;
+}
+
+static int compare_pointers(const void *a, const void *b)
+{
+    const char *p1 = *(const char **)a;
+    const char *p2 = *(const char **)b;
+    return (p1 > p2) - (p1 < p2);
+}
+
+static void count_tree(struct skin_size *size, struct skin_element *element)
+{
+    int i;
+
+    /* __PCTOOL__ builds keep pointers in the tree, not offsets */
+    for (; element; element = element->next)
+    {
+        size->elements++;
+        size->old_bytes += ALIGN(sizeof(struct old_skin_element)) -
+                           ALIGN(sizeof(struct skin_element));
+
+        /* comments don't keep their text in ROCKBOX mode */
+        if (element->type == TEXT)
+            add_string(element->data);
+
+        size->params += element->params_count;
+        size->old_bytes +=
+            ALIGN(sizeof(struct old_skin_tag_parameter) * element->params_count) -
+            ALIGN(sizeof(struct skin_tag_parameter) * element->params_count);
+        for (i = 0; i < element->params_count; i++)
+        {
+            struct skin_tag_parameter *param = &element->params[i];
+            if (param->type == STRING)
+                add_string(param->data.text);
+            else if (param->type == CODE)
+                count_tree(size, param->data.code);
+        }
+
+        for (i = 0; i < element->children_count; i++)
+            count_tree(size, element->children[i]);
+    }
+}
+
+/* shared strings are the same pointer seen more than once, the old layout
+ * had a copy of each */
+static void count_strings(struct skin_size *size)
+{
+    int i;
+
+    qsort(strings, strings_count, sizeof(*strings), compare_pointers);
+    size->strings = strings_count;
+    for (i = 1; i < strings_count; i++)
+    {
+        if (strings[i] == strings[i - 1])
+        {
+            size->shared++;
+            size->old_bytes += ALIGN(strlen(strings[i]) + 1);
+        }
+    }
+}
+
+static int parse_callback(struct skin_element *element, void *data)
+{
+    (void)element;
+    (void)data;
+    return CALLBACK_OK;
+}
+
+static char* read_file(const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    char *buffer;
+    long length;
+
+    if (!file)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    buffer = malloc(length + 1);
+    if (buffer)
+    {
+        length = fread(buffer, 1, length, file);
+        buffer[length] = '\0';
+    }
+    fclose(file);
+    return buffer;
+}
+
+static void print_size(const char *name, const struct skin_size *size)
+{
+    long saved = size->old_bytes - size->new_bytes;
+
+    printf("%s: %d elements, %d params, %d strings (%d shared)\n",
+           name, size->elements, size->params, size->strings, size->shared);
+    printf("    before %lu bytes, after %lu bytes, %ld saved (%ld%%)\n",
+           size->old_bytes, size->new_bytes, saved,
+           size->old_bytes ? saved * 100 / (long)size->old_bytes : 0);
+}
+
+int main(int argc, char **argv)
+{
+    struct skin_size total;
+    char *buffer;
+    int i, files = 0;
+
+    if (argc < 2)
+    {
+        printf("Usage: %s file.wps [file.sbs ...]\n", argv[0]);
+        return 1;
+    }
+
+    buffer = malloc(SKIN_BUFFER_SIZE);
+    if (!buffer)
+    {
+        printf("out of memory\n");
+        return 1;
+    }
+
+    printf("element %d -> %d bytes, parameter %d -> %d bytes, child %d bytes\n",
+           (int)sizeof(struct old_skin_element),
+           (int)sizeof(struct skin_element),
+           (int)sizeof(struct old_skin_tag_parameter),
+           (int)sizeof(struct skin_tag_parameter),
+           (int)sizeof(OFFSETTYPE(struct skin_element*)));
+
+    memset(&total, 0, sizeof(total));
+    for (i = 1; i < argc; i++)
+    {
+        struct skin_size size;
+        struct skin_element *tree;
+        char *document = read_file(argv[i]);
+
+        if (!document)
+        {
+            printf("%s: can't read file\n", argv[i]);
+            continue;
+        }
+
+        skin_buffer_init(buffer, SKIN_BUFFER_SIZE);
+        tree = skin_parse(document, parse_callback, NULL);
+        if (!tree)
+        {
+            printf("%s: line %d: %s\n", argv[i],
+                   skin_error_line(), skin_error_message());
+            free(document);
+            continue;
+        }
+
+        memset(&size, 0, sizeof(size));
+        size.new_bytes = skin_buffer_usage();
+        size.old_bytes = size.new_bytes;
+        strings_count = 0;
+        count_tree(&size, tree);
+        count_strings(&size);
+        print_size(argv[i], &size);
+
+        total.elements += size.elements;
+        total.params += size.params;
+        total.strings += size.strings;
+        total.shared += size.shared;
+        total.old_bytes += size.old_bytes;
+        total.new_bytes += size.new_bytes;
+        files++;
+
+        free(document);
+    }
+
+    if (files > 1)
+        print_size("total", &total);
+    free(strings);
+    free(buffer);
+    return 0;
+}
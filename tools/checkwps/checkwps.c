@@ -22,6 +22,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "config.h"
 #include "checkwps.h"
 #include "resize.h"
@@ -33,6 +34,7 @@
 #include "settings.h"
 #include "viewport.h"
 #include "file.h"
+#include "dir.h"
 #include "font.h"
 
 bool debug_wps = false;
@@ -279,16 +281,165 @@ struct font* font_get(int font)
 /* This is no longer defined in ROCKBOX builds so just use a huge value */
 #define SKIN_BUFFER_SIZE (200*1024)
 
+/* Results of checking a single skin */
+enum check_result {
+    CHECK_OK = 0,
+    CHECK_SKIPPED,
+    CHECK_BAD_EXT,
+    CHECK_PARSE_FAIL,
+};
+
+static struct wps_data wps;
+static int repeat = 1;
+static bool batch = false;
+
+/* Totals over all files of a batch run */
+static int total_files, total_failed;
+static clock_t total_time;
+static size_t max_usage;
+
+static enum check_result check_skin(const char *name)
+{
+    char *ext = strrchr(name, '.');
+    enum screen_type screen;
+    struct skin_stats stats;
+    clock_t best = 0;
+    int res = 0;
+
+    if (!batch)
+        printf("Checking %s...\n", name);
+    if (!ext)
+    {
+        printf("Invalid extension\n");
+        return CHECK_BAD_EXT;
+    }
+    ext++;
+    if (!strcmp(ext, "rwps") || !strcmp(ext, "rsbs") || !strcmp(ext, "rfms"))
+    {
+#ifdef HAVE_REMOTE_LCD
+        screen = SCREEN_REMOTE;
+#else
+        /* skip rwps etc. if not supported on this target (not an error) */
+        return CHECK_SKIPPED;
+#endif
+    }
+    else if (!strcmp(ext, "wps")  || !strcmp(ext, "sbs")  || !strcmp(ext, "fms"))
+    {
+        screen = SCREEN_MAIN;
+    }
+    else
+    {
+        printf("Invalid extension\n");
+        return CHECK_BAD_EXT;
+    }
+
+    /* every load parses into the same skin buffer, keep the fastest run */
+    for (int i = 0; i < repeat; i++)
+    {
+        skin_clear_errors();
+        clock_t start = clock();
+        res = skin_data_load(screen, &wps, name, true, &stats);
+        clock_t time = clock() - start;
+        if (!res)
+            break;
+        if (i == 0 || time < best)
+            best = time;
+    }
+
+    total_files++;
+    if (!res) {
+        total_failed++;
+        if (batch)
+            printf("%-50s FAIL\n", name);
+        else
+            printf("WPS parsing failure\n");
+        if (skin_error_line() > 0)
+            skin_error_format_message();
+        else
+            printf("Loading images or fonts failed.\n");
+        return CHECK_PARSE_FAIL;
+    }
+
+    total_time += best;
+    if (skin_buffer_usage() > max_usage)
+        max_usage = skin_buffer_usage();
+
+    if (batch)
+        printf("%-50s OK %8ld us %8lu bytes %8lu bytes images\n", name,
+               (long)(best * 1000000LL / CLOCKS_PER_SEC),
+               (unsigned long)skin_buffer_usage(),
+               (unsigned long)stats.images_size);
+    else
+        printf("WPS parsed OK\n\n");
+    if (wps_verbose_level>2)
+        skin_debug_tree(SKINOFFSETTOPTR(skin_buffer, wps.tree));
+    return CHECK_OK;
+}
+
+static int compare_names(const void *a, const void *b)
+{
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/* Checks every skin below a directory, in sorted order so the output of
+ * two runs over the same themes can be compared */
+static void check_dir(const char *path)
+{
+    DIR *dir = opendir(path);
+    struct dirent *entry;
+    char **names = NULL;
+    int count = 0, i;
+
+    if (!dir)
+    {
+        printf("%s: can't open directory\n", path);
+        total_failed++;
+        return;
+    }
+
+    while ((entry = readdir(dir)))
+    {
+        struct dirinfo info = dir_get_info(dir, entry);
+        char *ext = strrchr(entry->d_name, '.');
+        char **grown;
+
+        if (entry->d_name[0] == '.' && (!entry->d_name[1] ||
+            (entry->d_name[1] == '.' && !entry->d_name[2])))
+            continue;
+        if (!(info.attribute & ATTR_DIRECTORY) && (!ext ||
+            (strcmp(ext, ".wps") && strcmp(ext, ".sbs") &&
+             strcmp(ext, ".fms") && strcmp(ext, ".rwps") &&
+             strcmp(ext, ".rsbs") && strcmp(ext, ".rfms"))))
+            continue;
+
+        grown = realloc(names, (count + 1) * sizeof(char *));
+        if (!grown)
+            break;
+        names = grown;
+        names[count] = malloc(strlen(path) + strlen(entry->d_name) + 2);
+        if (!names[count])
+            break;
+        sprintf(names[count++], "%s/%s", path, entry->d_name);
+    }
+    closedir(dir);
+
+    qsort(names, count, sizeof(char *), compare_names);
+    for (i = 0; i < count; i++)
+    {
+        if (dir_exists(names[i]))
+            check_dir(names[i]);
+        else
+            check_skin(names[i]);
+        free(names[i]);
+    }
+    free(names);
+}
+
 int main(int argc, char **argv)
 {
     int ret = 0;
-    int res;
     int filearg = 1;
 
-    struct wps_data wps={0};
-    enum screen_type screen = SCREEN_MAIN;
-    struct screen* wps_screen;
-
     /* No arguments -> print the help text
      * Also print the help text upon -h or --help */
     if( (argc < 2) ||
@@ -296,21 +447,36 @@ int main(int argc, char **argv)
         strcmp(argv[1],"--help") == 0 )
     {
         printf("Usage: checkwps [OPTIONS] filename.wps [filename2.wps]...\n");
+        printf("       checkwps [OPTIONS] -b directory [directory2]...\n");
         printf("\nOPTIONS:\n");
         printf("\t-v\t\tverbose\n");
         printf("\t-vv\t\tmore verbose\n");
         printf("\t-vvv\t\tvery verbose\n");
+        printf("\t-b,\t--batch\tcheck all skins below the given directories,\n"
+               "\t\t\tprinting parse time and skin buffer usage\n");
+        printf("\t-r N\t\tparse every skin N times, report the best time\n");
         printf("\t-h,\t--help\tshow this message\n");
         return 1;
     }
 
-    if (argv[1][0] == '-') {
-        filearg++;
-        int i = 1;
-        while (argv[1][i] && argv[1][i] == 'v') {
-            i++;
-            wps_verbose_level++;
-            debug_wps = true;
+    while (argv[filearg] && argv[filearg][0] == '-') {
+        const char *opt = argv[filearg++];
+        if (!strcmp(opt, "-b") || !strcmp(opt, "--batch"))
+            batch = true;
+        else if (!strcmp(opt, "-r") && argv[filearg])
+        {
+            repeat = atoi(argv[filearg++]);
+            if (repeat < 1)
+                repeat = 1;
+        }
+        else
+        {
+            int i = 1;
+            while (opt[i] && opt[i] == 'v') {
+                i++;
+                wps_verbose_level++;
+                debug_wps = true;
+            }
         }
     }
     skin_buffer = malloc(SKIN_BUFFER_SIZE);
@@ -322,53 +488,30 @@ int main(int argc, char **argv)
 
     skin_buffer_init(skin_buffer, SKIN_BUFFER_SIZE);
 
+    if (batch)
+    {
+        /* Go through every skin in the directories, keep going on errors */
+        while (argv[filearg])
+            check_dir(argv[filearg++]);
+
+        printf("\n%d skins checked, %d failed, %ld us total parse time, "
+               "%lu bytes max skin buffer usage\n", total_files, total_failed,
+               (long)(total_time * 1000000LL / CLOCKS_PER_SEC),
+               (unsigned long)max_usage);
+        if (total_failed)
+            ret = 3;
+        goto done;
+    }
+
     /* Go through every skin that was thrown at us, error out at the first
      * flawed wps */
     while (argv[filearg]) {
-        const char* name = argv[filearg++];
-        char *ext = strrchr(name, '.');
-        struct skin_stats stats;
-        printf("Checking %s...\n", name);
-        if (!ext)
+        enum check_result res = check_skin(argv[filearg++]);
+        if (res == CHECK_BAD_EXT || res == CHECK_PARSE_FAIL)
         {
-            printf("Invalid extension\n");
-            ret = 2;
+            ret = res == CHECK_BAD_EXT ? 2 : 3;
             goto done;
         }
-        ext++;
-        if (!strcmp(ext, "rwps") || !strcmp(ext, "rsbs") || !strcmp(ext, "rfms"))
-        {
-#ifdef HAVE_REMOTE_LCD
-            screen = SCREEN_REMOTE;
-#else
-            /* skip rwps etc. if not supported on this target (not an error) */
-            continue;
-#endif
-        }
-        else if (!strcmp(ext, "wps")  || !strcmp(ext, "sbs")  || !strcmp(ext, "fms"))
-        {
-            screen = SCREEN_MAIN;
-        }
-        else
-        {
-            printf("Invalid extension\n");
-            ret = 2;
-            goto done;
-        }
-        wps_screen = &screens[screen];
-
-        res = skin_data_load(screen, &wps, name, true, &stats);
-
-        if (!res) {
-            printf("WPS parsing failure\n");
-            skin_error_format_message();
-            ret = 3;
-            goto done;
-        }
-
-        printf("WPS parsed OK\n\n");
-        if (wps_verbose_level>2)
-            skin_debug_tree(SKINOFFSETTOPTR(skin_buffer, wps.tree));
     }
 
 done:
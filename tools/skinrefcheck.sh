@@ -0,0 +1,79 @@
+#!/bin/bash
+#             __________               __   ___.
+#   Open      \______   \ ____   ____ |  | _\_ |__   _______  ___
+#   Source     |       _//  _ \_/ ___\|  |/ /| __ \ /  _ \  \/  /
+#   Jukebox    |    |   (  <_> )  \___|    < | \_\ (  <_> > <  <
+#   Firmware   |____|_  /\____/ \___  >__|_ \|___  /\____/__/\_ \
+#                     \/            \/     \/    \/            \/
+#
+################################################################################
+#
+# Pixel regression check for the skin engine, using the headless renderer of
+# the simulator (rockboxui --renderskin). Run it from a simulator build
+# directory after 'make install':
+#
+# ../tools/skinrefcheck.sh record <refdir> [frames]
+#   renders every WPS in simdisk/.rockbox/wps and keeps the frames in
+#   <refdir>/<skin>/frameNNNN.bmp
+#
+# ../tools/skinrefcheck.sh check <refdir> [frames]
+#   renders them again and compares against <refdir>, exits non-zero if any
+#   frame changed or has no reference
+#
+# Record with a build of the old tree and check with the new one. The frames
+# depend on the target's LCD, so keep one <refdir> per simulator target.
+#
+################################################################################
+
+set -uo pipefail
+
+if [ $# -lt 2 ] || { [ "$1" != "record" ] && [ "$1" != "check" ]; }; then
+  echo "Usage: $0 record|check <refdir> [frames]"
+  exit 1
+fi
+
+MODE=$1
+REFDIR=$2
+FRAMES=${3:-8}
+SIMDIR=".skinref" # where the frames go inside simdisk
+
+if [ ! -x ./rockboxui ] || [ ! -d simdisk/.rockbox/wps ]; then
+  echo "Run this from a simulator build directory after 'make install'"
+  exit 1
+fi
+
+# nobody looks at the window or listens while rendering
+export SDL_VIDEODRIVER=dummy
+export SDL_AUDIODRIVER=dummy
+
+rm -rf "simdisk/$SIMDIR"
+mkdir -p "simdisk/$SIMDIR" "$REFDIR"
+
+FAILED=0
+for WPS in simdisk/.rockbox/wps/*.wps; do
+  NAME=$(basename "$WPS" .wps)
+  if [ "$MODE" = "record" ]; then
+    ./rockboxui --renderskin "/.rockbox/wps/$NAME.wps" --frames "$FRAMES" \
+                --dumpdir "/$SIMDIR/$NAME" | grep -F "$NAME.wps"
+    STATUS=${PIPESTATUS[0]}
+    rm -rf "$REFDIR/$NAME"
+    if [ "$STATUS" -ne 0 ] ||
+       ! cp -r "simdisk/$SIMDIR/$NAME" "$REFDIR/$NAME"; then
+      echo "$NAME: FAILED"
+      FAILED=1
+    fi
+  else
+    if [ -d "$REFDIR/$NAME" ]; then
+      cp -r "$REFDIR/$NAME" "simdisk/$SIMDIR/$NAME"
+    fi
+    ./rockboxui --renderskin "/.rockbox/wps/$NAME.wps" --frames "$FRAMES" \
+                --refdir "/$SIMDIR/$NAME" | grep -E "^frame |$NAME.wps|changed"
+    if [ "${PIPESTATUS[0]}" -ne 0 ]; then
+      echo "$NAME: FAILED"
+      FAILED=1
+    fi
+  fi
+done
+
+rm -rf "simdisk/$SIMDIR"
+exit $FAILED
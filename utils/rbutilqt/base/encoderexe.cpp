@@ -57,7 +57,8 @@ bool EncoderExe::start()
 
 bool EncoderExe::encode(QString input,QString output)
 {
-    if (!configOk())
+    // encode() runs in parallel, use the settings loaded by start().
+    if (!QFileInfo::exists(m_EncExec))
         return false;
 
     QStringList args;
@@ -16,12 +16,98 @@
  *
  ****************************************************************************/
 
+#include <functional>
+#include <vector>
+
 #include "talkgenerator.h"
 #include "rbsettings.h"
 #include "playerbuildinfo.h"
 #include "wavtrim.h"
 #include "Logger.h"
 
+//! \brief Runs the jobs for the entries of a list on a bounded worker pool.
+//!
+//! Results are picked up in list order, so logging and progress behave the
+//! same as when running the entries one after another. Jobs that can't run
+//! in parallel are run by waitFor() on the calling thread instead.
+class TalkJobs
+{
+public:
+    TalkJobs(int count, bool parallel)
+        : m_parallel(parallel), m_jobs(count), m_state(count, Idle)
+    {
+        m_pool.setMaxThreadCount(QThread::idealThreadCount());
+    }
+
+    ~TalkJobs()
+    {
+        // drop jobs not started yet after an error or abort.
+        m_pool.clear();
+        m_pool.waitForDone();
+    }
+
+    void start(int index, std::function<void()> job)
+    {
+        if(!m_parallel) {
+            m_jobs[index] = job;
+            return;
+        }
+        m_state[index] = Queued;
+        m_pool.start(new Runner(this, index, job));
+    }
+
+    //! \brief wait for the job of an entry, keeping the UI responsive.
+    //! Returns false if aborted while waiting.
+    bool waitFor(int index, const bool* abort)
+    {
+        if(!m_parallel) {
+            if(m_jobs[index])
+                m_jobs[index]();
+            return true;
+        }
+        QMutexLocker locker(&m_mutex);
+        while(m_state[index] == Queued) {
+            if(*abort)
+                return false;
+            m_finished.wait(&m_mutex, 50);
+            locker.unlock();
+            QCoreApplication::processEvents();
+            locker.relock();
+        }
+        return true;
+    }
+
+private:
+    enum State { Idle, Queued, Done };
+
+    class Runner : public QRunnable
+    {
+    public:
+        Runner(TalkJobs* jobs, int index, std::function<void()> job)
+            : m_jobs(jobs), m_index(index), m_job(job) {}
+
+        void run()
+        {
+            m_job();
+            QMutexLocker locker(&m_jobs->m_mutex);
+            m_jobs->m_state[m_index] = Done;
+            m_jobs->m_finished.wakeAll();
+        }
+
+    private:
+        TalkJobs* m_jobs;
+        int m_index;
+        std::function<void()> m_job;
+    };
+
+    bool m_parallel;
+    std::vector<std::function<void()> > m_jobs;
+    std::vector<State> m_state;
+    QThreadPool m_pool;
+    QMutex m_mutex;
+    QWaitCondition m_finished;
+};
+
 TalkGenerator::TalkGenerator(QObject* parent): QObject(parent)
 {
 }
@@ -66,6 +152,8 @@ TalkGenerator::Status TalkGenerator::process(QList<TalkEntry>* list,int wavtrimt
     }
     QCoreApplication::processEvents();
 
+    setupCache(wavtrimth);
+
     emit logProgress(0,0);
 
     // Voice entries
@@ -111,78 +199,124 @@ TalkGenerator::Status TalkGenerator::process(QList<TalkEntry>* list,int wavtrimt
 //!
 TalkGenerator::Status TalkGenerator::voiceList(QList<TalkEntry>* list,int wavtrimth)
 {
+    enum Action { Skip, Duplicate, Cached, Voice };
+    struct Result
+    {
+        Action action;
+        TTSStatus status;
+        QString error;
+        bool trimFailed;
+    };
+
     int progressMax = list->size();
     int m_progress = 0;
     emit logProgress(m_progress,progressMax);
 
-    QStringList errors;
-    QStringList duplicates;
+    QSet<QString> duplicates;
+    std::vector<Result> results(list->size());
+    TalkJobs jobs(list->size(),
+                  m_tts->capabilities().testFlag(TTSBase::RunInParallel));
+    m_cacheFiles.clear();
 
-    bool warnings = false;
+    // queue all entries first, the results are collected in order below.
     for(int i=0; i < list->size(); i++)
     {
-        if(m_abort)
-        {
-            emit logItem(tr("Voicing aborted"), LOGERROR);
-            return eERROR;
-        }
+        Result& result = results[i];
+        result.action = Skip;
+        result.status = NoError;
+        result.trimFailed = false;
+        m_cacheFiles.append(QString());
 
         // skip duplicated wav entrys
-        if(!duplicates.contains(list->at(i).wavfilename))
-            duplicates.append(list->at(i).wavfilename);
-        else
+        if(duplicates.contains(list->at(i).wavfilename))
         {
-            LOG_INFO() << "duplicate skipped";
-            (*list)[i].voiced = true;
-            emit logProgress(++m_progress,progressMax);
+            result.action = Duplicate;
             continue;
         }
+        duplicates.insert(list->at(i).wavfilename);
 
-        // skip already voiced entrys
-        if(list->at(i).voiced == true)
-        {
-            emit logProgress(++m_progress,progressMax);
-            continue;
-        }
-        // skip entry whith empty text
-        if(list->at(i).toSpeak == "")
-        {
-            emit logProgress(++m_progress,progressMax);
+        // skip already voiced entrys and entries with empty text
+        if(list->at(i).voiced == true || list->at(i).toSpeak == "")
             continue;
-        }
 
-        // voice entry
-        QString error;
-        LOG_INFO() << "voicing: " << list->at(i).toSpeak
-                 << "to" << list->at(i).wavfilename;
-        TTSStatus status = m_tts->voice(list->at(i).toSpeak,
-                                        list->at(i).wavfilename, &error);
-        if(status == Warning)
+        // reuse the encoded clip if this string has been voiced before
+        QString cached = cacheFile(list->at(i).toSpeak);
+        if(!cached.isEmpty() && QFileInfo::exists(cached))
         {
-            warnings = true;
-            emit logItem(tr("Voicing of %1 failed: %2")
-                         .arg(list->at(i).toSpeak, error), LOGWARNING);
+            QFile::remove(list->at(i).talkfilename);
+            if(QFile::copy(cached, list->at(i).talkfilename))
+            {
+                result.action = Cached;
+                continue;
+            }
         }
-        else if (status == FatalError)
+        m_cacheFiles[i] = cached;
+
+        result.action = Voice;
+        QString text = list->at(i).toSpeak;
+        QString wavfile = list->at(i).wavfilename;
+        TTSBase* tts = m_tts;
+        jobs.start(i, [=, &result]() {
+            LOG_INFO() << "voicing: " << text << "to" << wavfile;
+            result.status = tts->voice(text, wavfile, &result.error);
+
+            // wavtrim if needed
+            if(result.status != FatalError && wavtrimth != -1)
+            {
+                char buffer[255];
+                if(wavtrim(wavfile.toLocal8Bit().data(),
+                           wavtrimth, buffer, 255))
+                    result.trimFailed = true;
+            }
+        });
+    }
+
+    bool warnings = false;
+    for(int i=0; i < list->size(); i++)
+    {
+        if(m_abort || !jobs.waitFor(i, &m_abort))
         {
-            emit logItem(tr("Voicing of %1 failed: %2")
-                         .arg(list->at(i).toSpeak, error), LOGERROR);
+            emit logItem(tr("Voicing aborted"), LOGERROR);
             return eERROR;
         }
-        else
-           (*list)[i].voiced = true;
 
-        // wavtrim if needed
-        if(wavtrimth != -1)
+        const Result& result = results[i];
+        switch(result.action)
         {
-            char buffer[255];
-            if(wavtrim(list->at(i).wavfilename.toLocal8Bit().data(),
-                       wavtrimth, buffer, 255))
+        case Duplicate:
+            LOG_INFO() << "duplicate skipped";
+            (*list)[i].voiced = true;
+            break;
+        case Cached:
+            LOG_INFO() << "cached clip used for" << list->at(i).toSpeak;
+            (*list)[i].voiced = true;
+            (*list)[i].encoded = true;
+            break;
+        case Voice:
+            if(result.status == Warning)
+            {
+                warnings = true;
+                emit logItem(tr("Voicing of %1 failed: %2")
+                             .arg(list->at(i).toSpeak, result.error), LOGWARNING);
+            }
+            else if (result.status == FatalError)
+            {
+                emit logItem(tr("Voicing of %1 failed: %2")
+                             .arg(list->at(i).toSpeak, result.error), LOGERROR);
+                return eERROR;
+            }
+            else
+               (*list)[i].voiced = true;
+
+            if(result.trimFailed)
             {
                 LOG_ERROR() << "wavtrim returned error on"
                             << list->at(i).wavfilename;
                 return eERROR;
             }
+            break;
+        default:
+            break;
         }
 
         emit logProgress(++m_progress,progressMax);
@@ -199,55 +333,153 @@ TalkGenerator::Status TalkGenerator::voiceList(QList<TalkEntry>* list,int wavtri
 //!
 TalkGenerator::Status TalkGenerator::encodeList(QList<TalkEntry>* list)
 {
-    QStringList duplicates;
+    enum Action { Skip, NotVoiced, Duplicate, Encode };
+    struct Result
+    {
+        Action action;
+        bool ok;
+    };
+
+    QSet<QString> duplicates;
+    std::vector<Result> results(list->size());
 
     int progressMax = list->size();
     int m_progress = 0;
     emit logProgress(m_progress,progressMax);
 
+    // the encoders keep no state between files, so they always run in parallel.
+    TalkJobs jobs(list->size(), true);
     for(int i=0; i < list->size(); i++)
     {
-        if(m_abort)
-        {
-            emit logItem(tr("Encoding aborted"), LOGERROR);
-            return eERROR;
-        }
+        Result& result = results[i];
+        result.action = Skip;
+        result.ok = true;
 
          //skip non-voiced entrys
         if(list->at(i).voiced == false)
         {
-            LOG_WARNING() << "non voiced entry detected:"
-                          << list->at(i).toSpeak;
-            emit logProgress(++m_progress,progressMax);
+            result.action = NotVoiced;
             continue;
         }
+        //skip entries taken from the cache
+        if(list->at(i).encoded == true)
+            continue;
         //skip duplicates
-         if(!duplicates.contains(list->at(i).talkfilename))
-            duplicates.append(list->at(i).talkfilename);
-        else
+        if(duplicates.contains(list->at(i).talkfilename))
         {
-            LOG_INFO() << "duplicate skipped";
-            (*list)[i].encoded = true;
-            emit logProgress(++m_progress,progressMax);
+            result.action = Duplicate;
             continue;
         }
+        duplicates.insert(list->at(i).talkfilename);
 
         //encode entry
-        LOG_INFO() << "encoding " << list->at(i).wavfilename
-                   << "to" << list->at(i).talkfilename;
-        if(!m_enc->encode(list->at(i).wavfilename,list->at(i).talkfilename))
+        result.action = Encode;
+        QString wavfile = list->at(i).wavfilename;
+        QString talkfile = list->at(i).talkfilename;
+        EncoderBase* enc = m_enc;
+        jobs.start(i, [=, &result]() {
+            LOG_INFO() << "encoding " << wavfile << "to" << talkfile;
+            result.ok = enc->encode(wavfile, talkfile);
+        });
+    }
+
+    for(int i=0; i < list->size(); i++)
+    {
+        if(m_abort || !jobs.waitFor(i, &m_abort))
         {
-            emit logItem(tr("Encoding of %1 failed").arg(
-                QFileInfo(list->at(i).wavfilename).baseName()), LOGERROR);
+            emit logItem(tr("Encoding aborted"), LOGERROR);
             return eERROR;
         }
-        (*list)[i].encoded = true;
+
+        switch(results[i].action)
+        {
+        case NotVoiced:
+            LOG_WARNING() << "non voiced entry detected:"
+                          << list->at(i).toSpeak;
+            break;
+        case Duplicate:
+            LOG_INFO() << "duplicate skipped";
+            (*list)[i].encoded = true;
+            break;
+        case Encode:
+            if(!results[i].ok)
+            {
+                emit logItem(tr("Encoding of %1 failed").arg(
+                    QFileInfo(list->at(i).wavfilename).baseName()), LOGERROR);
+                return eERROR;
+            }
+            (*list)[i].encoded = true;
+            if(i < m_cacheFiles.size() && !m_cacheFiles.at(i).isEmpty())
+                QFile::copy(list->at(i).talkfilename, m_cacheFiles.at(i));
+            break;
+        default:
+            break;
+        }
+
         emit logProgress(++m_progress,progressMax);
         QCoreApplication::processEvents();
     }
     return eOK;
 }
 
+//! \brief Sets up the cache of encoded clips.
+//! The clips are kept by a hash of their text and of all settings which
+//! change the outcome, so unchanged strings are never voiced again.
+//!
+void TalkGenerator::setupCache(int wavtrimth)
+{
+    m_cachePath.clear();
+    if(RbSettings::value(RbSettings::CacheDisabled).toBool())
+        return;
+
+    QString path = RbSettings::value(RbSettings::CachePath).toString();
+    if(path.isEmpty())
+        path = QDir::tempPath();
+    path += "/rbutil-talkcache";
+    if(!QDir().mkpath(path))
+    {
+        LOG_WARNING() << "could not create talk clip cache" << path;
+        return;
+    }
+    m_cachePath = path;
+
+    QString tts = RbSettings::value(RbSettings::Tts).toString();
+    QString enc = PlayerBuildInfo::instance()->value(
+                    PlayerBuildInfo::Encoder).toString();
+    const RbSettings::UserSettings ttsSettings[] = {
+        RbSettings::TtsPath, RbSettings::TtsOptions, RbSettings::TtsVoice,
+        RbSettings::TtsLanguage, RbSettings::TtsSpeed, RbSettings::TtsPitch,
+        RbSettings::TtsUseSapi4,
+    };
+    const RbSettings::UserSettings encSettings[] = {
+        RbSettings::EncoderPath, RbSettings::EncoderOptions,
+        RbSettings::EncoderQuality, RbSettings::EncoderComplexity,
+        RbSettings::EncoderVolume, RbSettings::EncoderNarrowBand,
+    };
+
+    QStringList settings;
+    settings << tts << m_tts->voiceVendor();
+    for(const RbSettings::UserSettings s : ttsSettings)
+        settings << RbSettings::subValue(tts, s).toString();
+    settings << enc;
+    for(const RbSettings::UserSettings s : encSettings)
+        settings << RbSettings::subValue(enc, s).toString();
+    settings << QString::number(wavtrimth);
+    m_cacheSettings = settings.join("\n");
+}
+
+//! \brief Returns the cache file for the clip of a string, or an empty
+//! string if the cache is disabled.
+//!
+QString TalkGenerator::cacheFile(const QString& text)
+{
+    if(m_cachePath.isEmpty())
+        return QString();
+    return m_cachePath + "/"
+        + QCryptographicHash::hash((m_cacheSettings + "\n" + text).toUtf8(),
+                                   QCryptographicHash::Md5).toHex() + ".enc";
+}
+
 //! \brief slot, which is connected to the abort of the Logger.
 //Sets a flag, so Creating Talkfiles ends at the next possible position
 //!
@@ -67,6 +67,8 @@ signals:
 private:
     Status voiceList(QList<TalkEntry>* list,int wavetrimth);
     Status encodeList(QList<TalkEntry>* list);
+    void setupCache(int wavtrimth);
+    QString cacheFile(const QString& text);
 
     TTSBase* m_tts;
     EncoderBase* m_enc;
@@ -83,6 +85,11 @@ private:
 
     bool m_abort;
 
+    //! encoded clips by hash of their text and the TTS / encoder settings
+    QString m_cachePath;
+    QString m_cacheSettings;
+    QStringList m_cacheFiles;
+
 
 };
 
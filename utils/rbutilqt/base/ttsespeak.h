@@ -35,7 +35,7 @@ class TTSEspeak : public TTSExes
             /* default to espeak */
             m_TTSTemplate = "\"%exe\" %options -w \"%wavfile\" -- \"%text\"";
             m_TTSSpeakTemplate = "\"%exe\" %options -- \"%text\"";
-            m_capabilities = TTSBase::CanSpeak;
+            m_capabilities = TTSBase::CanSpeak | TTSBase::RunInParallel;
         }
 };
 
@@ -34,7 +34,7 @@ class TTSEspeakNG : public TTSExes
 
             m_TTSTemplate = "\"%exe\" %options -w \"%wavfile\" -- \"%text\"";
             m_TTSSpeakTemplate = "\"%exe\" %options -- \"%text\"";
-            m_capabilities = TTSBase::CanSpeak;
+            m_capabilities = TTSBase::CanSpeak | TTSBase::RunInParallel;
         }
 };
 
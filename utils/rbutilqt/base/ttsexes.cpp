@@ -26,7 +26,7 @@ TTSExes::TTSExes(QObject* parent) : TTSBase(parent)
 {
     /* default to espeak */
     m_name = "espeak";
-    m_capabilities = TTSBase::CanSpeak;
+    m_capabilities = TTSBase::CanSpeak | TTSBase::RunInParallel;
     m_TTSTemplate = "\"%exe\" %options -w \"%wavfile\" -- \"%text\"";
     m_TTSSpeakTemplate = "\"%exe\" %options -- \"%text\"";
 }
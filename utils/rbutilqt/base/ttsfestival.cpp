@@ -151,6 +151,10 @@ bool TTSFestival::start(QString* errStr)
     LOG_INFO() << "Starting server with voice"
                << RbSettings::subValue("festival", RbSettings::TtsVoice).toString();
 
+    // voice() runs in parallel, so it must not access the settings itself.
+    clientPath = RbSettings::subValue("festival-client",
+            RbSettings::TtsPath).toString();
+
     bool running = ensureServerRunning();
     if (!RbSettings::subValue("festival",RbSettings::TtsVoice).toString().isEmpty())
     {
@@ -186,8 +190,7 @@ TTSStatus TTSFestival::voice(const QString& text, const QString& wavfile, QStrin
 {
     LOG_INFO() << "Voicing" << text << "->" << wavfile;
 
-    QString path = RbSettings::subValue("festival-client",
-            RbSettings::TtsPath).toString();
+    QString path = clientPath;
     QStringList cmd;
     cmd << "--server" << "localhost" << "--otype" << "riff" << "--ttw"
         << "--withlisp" << "--output" << wavfile << "--prolog" << prologPath << "-";
@@ -34,7 +34,7 @@ class TTSMimic : public TTSExes
 
             m_TTSTemplate = "\"%exe\" %options -o \"%wavfile\" -t \"%text\"";
             m_TTSSpeakTemplate = "\"%exe\" %options -t \"%text\"";
-            m_capabilities = TTSBase::CanSpeak;
+            m_capabilities = TTSBase::CanSpeak | TTSBase::RunInParallel;
         }
 };
 
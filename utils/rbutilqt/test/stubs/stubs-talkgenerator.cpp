@@ -47,6 +47,11 @@ QVariant RbSettings::value(UserSettings setting)
     }
 }
 
+QVariant RbSettings::subValue(QString /*sub*/, UserSettings /*setting*/)
+{
+    return QVariant();
+}
+
 class TTSFakeEspeak : public TTSBase
 {
     Q_OBJECT
@@ -42,11 +42,26 @@ RBScene::~RBScene()
 
 void RBScene::clear()
 {
+    /* The console outlives the rendered items, so it's taken out of the
+     * scene while that gets emptied instead of being created again */
+    if(consoleProxy)
+        removeItem(consoleProxy);
+
     QGraphicsScene::clear();
 
-    console = new RBConsole();
-    consoleProxy = addWidget(console);
-    consoleProxy->setZValue(1000);
+    if(!consoleProxy)
+    {
+        console = new RBConsole();
+        consoleProxy = new QGraphicsProxyWidget();
+        consoleProxy->setWidget(console);
+        consoleProxy->setZValue(1000);
+    }
+    else
+    {
+        console->clear();
+    }
+
+    addItem(consoleProxy);
     consoleProxy->resize(screen.width(), screen.height());
     consoleProxy->hide();
 }
@@ -39,3 +39,8 @@ void RBConsole::addWarning(QString warning)
     ui->output->appendHtml("<span style = \"color:orange\">" + warning
                            + "</span>");
 }
+
+void RBConsole::clear()
+{
+    ui->output->clear();
+}
@@ -35,6 +35,7 @@ public:
     ~RBConsole();
 
     void addWarning(QString warning);
+    void clear();
 
 private:
     Ui::RBConsole *ui;
@@ -31,6 +31,8 @@
 #include <QPixmap>
 #include <QMap>
 #include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
 
 #include <iostream>
 
@@ -40,9 +42,14 @@ ParseTreeModel::ParseTreeModel(const char* document, QObject* parent):
     this->tree = skin_parse(document);
 
     if(tree)
+    {
         this->root = new ParseTreeNode(tree, this);
+        parsed = document;
+    }
     else
+    {
         this->root = 0;
+    }
 
     scene = new RBScene();
 }
@@ -68,7 +75,40 @@ QString ParseTreeModel::genCode()
 
 QString ParseTreeModel::changeTree(const char *document)
 {
-    struct skin_element* test = skin_parse(document);
+    QByteArray text(document);
+    struct skin_element* test;
+
+    if(tree && !parsed.isNull() && text == parsed)
+    {
+        skin_clear_errors();
+        return tr("Document Parses Successfully");
+    }
+
+    if(tree && !parsed.isNull())
+    {
+        /* Only the lines that changed since the last parse are parsed again */
+        QList<QByteArray> oldLines = parsed.split('\n');
+        QList<QByteArray> newLines = text.split('\n');
+        int prefix = 0;
+        int suffix = 0;
+
+        while(prefix < oldLines.count() && prefix < newLines.count()
+              && oldLines[prefix] == newLines[prefix])
+            prefix++;
+        while(suffix < oldLines.count() - prefix
+              && suffix < newLines.count() - prefix
+              && oldLines[oldLines.count() - suffix - 1]
+                 == newLines[newLines.count() - suffix - 1])
+            suffix++;
+
+        test = skin_reparse(tree, document, prefix + 1,
+                            newLines.count() - suffix,
+                            newLines.count() - oldLines.count());
+    }
+    else
+    {
+        test = skin_parse(document);
+    }
 
     if(!test)
     {
@@ -79,19 +119,27 @@ QString ParseTreeModel::changeTree(const char *document)
         return error;
     }
 
-    ParseTreeNode* temp = new ParseTreeNode(test, this);
+    beginResetModel();
 
-    if(root)
+    if(!tree)
+    {
+        root = new ParseTreeNode(test, this);
+    }
+    else if(parsed.isNull())
     {
-        emit beginRemoveRows(QModelIndex(), 0, root->numChildren() - 1);
         delete root;
-        emit endRemoveRows();
+        skin_free_tree(tree);
+        root = new ParseTreeNode(test, this);
+    }
+    else
+    {
+        root->spliceChildren(test);
     }
 
-    root = temp;
+    tree = test;
+    parsed = text;
 
-    emit beginInsertRows(QModelIndex(), 0, temp->numChildren() - 1);
-    emit endInsertRows();
+    endResetModel();
 
     return tr("Document Parses Successfully");
 
@@ -268,6 +316,9 @@ bool ParseTreeModel::setData(const QModelIndex &index, const QVariant &value,
         element->data = strdup(value.toString().trimmed().toLatin1());
     }
 
+    /* The tree doesn't match the parsed text anymore */
+    parsed = QByteArray();
+
     emit dataChanged(index, index);
     return true;
 }
@@ -325,12 +376,20 @@ RBScene* ParseTreeModel::render(ProjectModel* project,
 
         if(QFile::exists(sbsFile))
         {
-            QFile sbs(sbsFile);
-            sbs.open(QFile::ReadOnly | QFile::Text);
-
-            if(sbsModel)
-                sbsModel->deleteLater();
-            sbsModel = new ParseTreeModel(QString(sbs.readAll()).toLatin1());
+            /* The SBS only gets parsed again if it changed on disk */
+            QDateTime modified = QFileInfo(sbsFile).lastModified();
+            if(!sbsModel || sbsFile != sbsPath || modified != sbsModified)
+            {
+                QFile sbs(sbsFile);
+                sbs.open(QFile::ReadOnly | QFile::Text);
+
+                if(sbsModel)
+                    sbsModel->deleteLater();
+                sbsModel = new ParseTreeModel(QString(sbs.readAll())
+                                              .toLatin1());
+                sbsPath = sbsFile;
+                sbsModified = modified;
+            }
 
             if(sbsModel->root != 0)
             {
@@ -373,6 +432,8 @@ RBScene* ParseTreeModel::render(ProjectModel* project,
 
 void ParseTreeModel::paramChanged(ParseTreeNode *param)
 {
+    parsed = QByteArray();
+
     QModelIndex left = indexFromPointer(param);
     QModelIndex right = createIndex(left.row(), 2, left.internalPointer());
     emit dataChanged(left, right);
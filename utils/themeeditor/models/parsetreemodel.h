@@ -29,6 +29,8 @@
 
 #include <QAbstractItemModel>
 #include <QList>
+#include <QByteArray>
+#include <QDateTime>
 
 #include "parsetreenode.h"
 #include "devicestate.h"
@@ -84,7 +86,10 @@ private:
 
     ParseTreeNode* root;
     ParseTreeModel* sbsModel;
+    QString sbsPath;
+    QDateTime sbsModified;
     struct skin_element* tree;
+    QByteArray parsed; /* Document tree was parsed from, if unmodified */
     RBScene* scene;
 };
 
@@ -119,6 +119,37 @@ ParseTreeNode::~ParseTreeNode()
         delete children[i];
 }
 
+/* Rebuilds the children of a root node after skin_reparse(), keeping the
+ * nodes of the viewports that weren't parsed again. The replaced viewports
+ * are only freed after their replacements have been allocated, so a new
+ * viewport never shares the address of an old one */
+void ParseTreeNode::spliceChildren(struct skin_element* data)
+{
+    QList<ParseTreeNode*> old = children;
+    children.clear();
+
+    while(data)
+    {
+        ParseTreeNode* node = 0;
+        for(int i = 0; i < old.count(); i++)
+        {
+            if(old[i]->element == data)
+            {
+                node = old.takeAt(i);
+                break;
+            }
+        }
+
+        if(!node)
+            node = new ParseTreeNode(data, this, model);
+        children.append(node);
+        data = data->next;
+    }
+
+    for(int i = 0; i < old.count(); i++)
+        delete old[i];
+}
+
 QString ParseTreeNode::genCode() const
 {
     QString buffer = "";
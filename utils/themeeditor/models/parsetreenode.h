@@ -41,6 +41,8 @@ public:
                   ParseTreeModel* model);
     virtual ~ParseTreeNode();
 
+    void spliceChildren(struct skin_element* data);
+
     QString genCode() const;
     int genHash() const;
 